@@ -0,0 +1,239 @@
+#include "glutils/gl.hpp"
+#include "glutils/buffer.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gpu_primitives.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Checks GL::GpuPrimitives against CPU references on a real context and times it with GL timer queries.
+// Usage: glutils_gpu_check [work group size]. Exits with a non-zero status on the first mismatch.
+
+namespace {
+
+/// Make a GL 4.5 core context current without a window, on the Mesa surfaceless platform if available.
+void makeContextCurrent()
+{
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (get_platform_display)
+        display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    if (!eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API))
+        throw GL::Error("failed to initialize EGL");
+
+    const EGLint attributes[]{EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, 5,
+                              EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE};
+    const auto context = eglCreateContext(display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+        throw GL::Error("failed to create a surfaceless OpenGL 4.5 context");
+
+    GL::loadContext(reinterpret_cast<GLADloadfunc>(eglGetProcAddress));
+}
+
+template<typename T>
+auto makeBuffer(const std::vector<T> &data) -> GL::Buffer
+{
+    GL::Buffer buffer;
+    buffer.allocate(GLsizeiptr(std::max<std::size_t>(data.size(), 1) * 4), GL::BufferHandle::Usage::dynamic_copy,
+                    data.empty() ? nullptr : data.data());
+    return buffer;
+}
+
+template<typename T>
+auto readBuffer(GL::BufferHandle buffer, std::size_t count) -> std::vector<T>
+{
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    std::vector<T> data(count);
+    if (count > 0)
+        buffer.read(0, GLsizeiptr(count * 4), data.data());
+    return data;
+}
+
+template<typename T>
+void expect(const char *name, GLuint count, const std::vector<T> &actual, const std::vector<T> &expected)
+{
+    const auto mismatch = std::mismatch(actual.begin(), actual.end(), expected.begin());
+    if (mismatch.first == actual.end())
+        return;
+
+    std::cerr << name << "(" << count << "): element " << (mismatch.first - actual.begin()) << " is "
+              << *mismatch.first << ", expected " << *mismatch.second << "\n";
+    std::exit(EXIT_FAILURE);
+}
+
+void check(GL::GpuPrimitives &primitives, GLuint count, std::mt19937 &random)
+{
+    using ValueType = GL::GpuPrimitives::ValueType;
+    using ReduceOp = GL::GpuPrimitives::ReduceOp;
+
+    std::vector<std::uint32_t> uints(count);
+    std::vector<std::int32_t> ints(count);
+    std::vector<float> floats(count);
+    std::vector<std::uint32_t> flags(count);
+    for (GLuint i = 0; i < count; i++)
+    {
+        uints[i] = random();
+        ints[i] = std::int32_t(random() % 2001) - 1000;
+        floats[i] = float(std::int32_t(random() % 2001) - 1000) * 0.25f;
+        flags[i] = random() % 3 == 0;
+    }
+
+    // scans of small values, so the sums are exact
+    std::vector<std::uint32_t> small(count);
+    std::transform(uints.begin(), uints.end(), small.begin(), [](std::uint32_t value) { return value & 0xFF; });
+
+    {
+        auto input = makeBuffer(small);
+        auto output = makeBuffer(small);
+
+        std::vector<std::uint32_t> expected(count);
+        std::exclusive_scan(small.begin(), small.end(), expected.begin(), 0u);
+        primitives.exclusiveScan({input}, {output}, count);
+        expect("exclusiveScan", count, readBuffer<std::uint32_t>(output, count), expected);
+
+        std::inclusive_scan(small.begin(), small.end(), expected.begin());
+        primitives.inclusiveScan({input}, {input}, count);
+        expect("inclusiveScan in place", count, readBuffer<std::uint32_t>(input, count), expected);
+    }
+
+    {
+        auto input = makeBuffer(uints);
+        auto output = makeBuffer(std::vector<std::uint32_t>(1));
+        primitives.reduce({input}, {output}, count, ReduceOp::sum);
+        expect("reduce(sum, uint32)", count, readBuffer<std::uint32_t>(output, 1),
+               {std::accumulate(uints.begin(), uints.end(), 0u)});
+
+        input = makeBuffer(ints);
+        primitives.reduce({input}, {output}, count, ReduceOp::min, ValueType::int32);
+        expect("reduce(min, int32)", count, readBuffer<std::int32_t>(output, 1),
+               {count ? *std::min_element(ints.begin(), ints.end()) : std::int32_t(0x7FFFFFFF)});
+
+        input = makeBuffer(floats);
+        primitives.reduce({input}, {output}, count, ReduceOp::max, ValueType::float32);
+        const auto max = readBuffer<float>(output, 1);
+        if (count)
+            expect("reduce(max, float32)", count, max, {*std::max_element(floats.begin(), floats.end())});
+    }
+
+    {
+        auto keys = makeBuffer(uints);
+        std::vector<std::uint32_t> indices(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        auto values = makeBuffer(indices);
+
+        // a stable sort by the low 12 bits, so equal keys are common and stability shows in the values
+        std::stable_sort(indices.begin(), indices.end(), [&](std::uint32_t lhs, std::uint32_t rhs)
+        { return (uints[lhs] & 0xFFF) < (uints[rhs] & 0xFFF); });
+        std::vector<std::uint32_t> expected(count);
+        for (GLuint i = 0; i < count; i++)
+            expected[i] = uints[indices[i]];
+
+        primitives.sortKeyValue({keys}, {values}, count, 12);
+        expect("sortKeyValue values", count, readBuffer<std::uint32_t>(values, count), indices);
+        expect("sortKeyValue keys", count, readBuffer<std::uint32_t>(keys, count), expected);
+
+        keys = makeBuffer(uints);
+        expected = uints;
+        std::sort(expected.begin(), expected.end());
+        primitives.sort({keys}, count);
+        expect("sort", count, readBuffer<std::uint32_t>(keys, count), expected);
+    }
+
+    {
+        auto input = makeBuffer(uints);
+        auto flag_buffer = makeBuffer(flags);
+        auto output = makeBuffer(uints);
+        auto output_count = makeBuffer(std::vector<std::uint32_t>(1));
+
+        std::vector<std::uint32_t> expected;
+        for (GLuint i = 0; i < count; i++)
+            if (flags[i])
+                expected.push_back(uints[i]);
+
+        primitives.compact({input}, {flag_buffer}, {output}, {output_count}, count);
+        expect("compact count", count, readBuffer<std::uint32_t>(output_count, 1),
+               {std::uint32_t(expected.size())});
+        expect("compact", count, readBuffer<std::uint32_t>(output, expected.size()), expected);
+    }
+}
+
+/// Runs @p function @p iterations times and prints the mean GPU time, measured with GL_TIMESTAMP queries.
+template<class Function>
+void measure(const char *name, GLuint count, int iterations, Function &&function)
+{
+    GLuint queries[2];
+    glCreateQueries(GL_TIMESTAMP, 2, queries);
+
+    // warm up, so kernels are built and scratch memory is allocated
+    function();
+
+    glQueryCounter(queries[0], GL_TIMESTAMP);
+    for (int i = 0; i < iterations; i++)
+        function();
+    glQueryCounter(queries[1], GL_TIMESTAMP);
+
+    GLuint64 start = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+    glDeleteQueries(2, queries);
+
+    const double ms = double(end - start) / 1e6 / iterations;
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << ms << " ms"
+              << std::setw(10) << std::setprecision(1) << double(count) / ms / 1e3 << " Melem/s\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        const auto work_group_size = argc > 1 ? GLuint(std::strtoul(argv[1], nullptr, 10)) : 256u;
+
+        makeContextCurrent();
+        std::cout << glGetString(GL_RENDERER) << ", work group size " << work_group_size << "\n";
+
+        GL::GpuPrimitives primitives(work_group_size);
+        std::mt19937 random(42);
+
+        const auto block = primitives.getBlockSize();
+        for (const GLuint count: {0u, 1u, 17u, block - 1, block, block + 1, block * block + 3, 3000000u})
+            check(primitives, count, random);
+        std::cout << "all results match the CPU references\n";
+
+        constexpr GLuint count = 1 << 22;
+        std::vector<std::uint32_t> data(count);
+        std::generate(data.begin(), data.end(), random);
+        auto keys = makeBuffer(data);
+        auto values = makeBuffer(data);
+
+        measure("exclusiveScan(4M)", count, 10, [&] { primitives.exclusiveScan({keys}, {values}, count); });
+        measure("reduce(sum, 4M)", count, 10, [&]
+        { primitives.reduce({keys}, {values}, count, GL::GpuPrimitives::ReduceOp::sum); });
+        measure("sortKeyValue(4M)", count, 3, [&] { primitives.sortKeyValue({keys}, {values}, count); });
+    }
+    catch (const GL::Error &error)
+    {
+        std::cerr << error.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
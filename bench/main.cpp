@@ -0,0 +1,229 @@
+#include "glutils/gl.hpp"
+#include "glutils/null_context.hpp"
+#include "glutils/block_compression.hpp"
+#include "glutils/buffer.hpp"
+#include "glutils/gpu_primitives.hpp"
+#include "glutils/program.hpp"
+#include "glutils/sampler_cache.hpp"
+#include "glutils/texture.hpp"
+#include "glutils/texture_binding_tracker.hpp"
+#include "glutils/texture_readback.hpp"
+#include "glutils/vertex_array.hpp"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Runs @p function @p iterations times against the null context and prints the time and GL calls per iteration.
+template<class Function>
+void run(const char *name, std::size_t iterations, Function &&function)
+{
+    GL::Null::resetCallCounts();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++)
+        function(i);
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count() / double(iterations);
+    const double calls = double(GL::Null::getTotalCallCount()) / double(iterations);
+
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << ns << " ns/iter"
+              << std::setw(8) << calls << " GL calls/iter\n";
+}
+
+/// Compresses a synthetic image in @p format and prints the throughput, and the PSNR against the reference decoder.
+void runBlockCompression(const char *name, GL::BlockFormat format, int channels)
+{
+    constexpr GLsizei size = 1024;
+    std::vector<std::uint8_t> pixels(std::size_t(size) * size * 4);
+    for (GLsizei y = 0; y < size; y++)
+    {
+        for (GLsizei x = 0; x < size; x++)
+        {
+            // a little noise, so every block has more values than the endpoints of BC4/BC5 can represent exactly
+            const auto noise = (std::uint32_t(x) * 73856093u ^ std::uint32_t(y) * 19349663u) % 9;
+            const auto pixel = &pixels[(std::size_t(y) * size + x) * 4];
+            pixel[0] = std::uint8_t(x * 240 / size + noise);
+            pixel[1] = std::uint8_t(y * 240 / size + (noise * 5) % 9);
+            pixel[2] = std::uint8_t((x ^ y) & 0xFF);
+            pixel[3] = std::uint8_t(128.0 + 127.0 * std::sin(x * 0.05));
+        }
+    }
+
+    std::vector<std::uint8_t> blocks(GL::getCompressedSize(format, size, size));
+    constexpr int repetitions = 8;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        GL::compressBlocks(format, pixels.data(), size, size, blocks.data());
+    const auto end = std::chrono::steady_clock::now();
+
+    std::vector<std::uint8_t> decoded(pixels.size());
+    GL::decompressBlocks(format, blocks.data(), size, size, decoded.data());
+
+    double squared_error = 0.0;
+    for (std::size_t i = 0; i < pixels.size(); i++)
+    {
+        if (int(i % 4) < channels)
+            squared_error += std::pow(double(pixels[i]) - double(decoded[i]), 2.0);
+    }
+    const double mse = squared_error / (double(size) * size * channels);
+    const double mpix = double(size) * size * repetitions / 1e6
+                        / std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << mpix << " MPix/s"
+              << std::setw(10) << 10.0 * std::log10(255.0 * 255.0 / mse) << " dB PSNR\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    GL::loadContext(GL::Null::getProcAddress);
+
+    run("Buffer lifetime", iterations, [](std::size_t)
+    {
+        GL::Buffer buffer;
+    });
+
+    run("Texture lifetime", iterations, [](std::size_t)
+    {
+        GL::Texture texture(GL::TextureHandle::Type::_2d);
+    });
+
+    run("VertexArray lifetime", iterations, [](std::size_t)
+    {
+        GL::VertexArray vertex_array;
+    });
+
+    std::array<GL::Buffer, 8> buffers;
+    std::array<std::pair<GL::BufferHandle, GL::BufferHandle::Range>, buffers.size()> ranges;
+    for (std::size_t i = 0; i < buffers.size(); i++)
+    {
+        buffers[i].allocate(1024, GL::BufferHandle::Usage::static_draw);
+        ranges[i] = {buffers[i], {0, 1024}};
+    }
+
+    run("BufferHandle::bindRanges(8)", iterations, [&](std::size_t)
+    {
+        GL::BufferHandle::bindRanges(GL::BufferHandle::IndexedTarget::uniform, 0, ranges.begin(), ranges.end());
+    });
+
+    run("BufferHandle::bindBases(8)", iterations, [&](std::size_t)
+    {
+        GL::BufferHandle::bindBases(GL::BufferHandle::IndexedTarget::shader_storage, 0, buffers.begin(),
+                                    buffers.end());
+    });
+
+    run("BufferHandle::write", iterations, [&](std::size_t i)
+    {
+        buffers[i % buffers.size()].write(0, sizeof(i), &i);
+    });
+
+    GL::Program program;
+
+    run("ProgramHandle::setUniform(float)", iterations, [&](std::size_t i)
+    {
+        program.setUniform(0, float(i));
+    });
+
+    run("ProgramHandle::setUniform(vec4)", iterations, [&](std::size_t i)
+    {
+        program.setUniform(1, glm::vec4{float(i), 0.0f, 0.0f, 1.0f});
+    });
+
+    run("ProgramHandle::setUniform(uint[4])", iterations, [&](std::size_t i)
+    {
+        const GLuint values[4]{GLuint(i), 1, 2, 3};
+        program.setUniform(2, 4, values);
+    });
+
+    const glm::mat4 matrix{};
+
+    run("ProgramHandle::setUniformMatrix(mat4)", iterations, [&](std::size_t)
+    {
+        program.setUniformMatrix(3, 1, false, &matrix);
+    });
+
+    GL::GpuPrimitives primitives;
+    GL::Buffer keys;
+    GL::Buffer values;
+    keys.allocate(1 << 22, GL::BufferHandle::Usage::dynamic_copy);
+    values.allocate(1 << 22, GL::BufferHandle::Usage::dynamic_copy);
+
+    run("GpuPrimitives::exclusiveScan(1M)", iterations / 100, [&](std::size_t)
+    {
+        primitives.exclusiveScan({keys}, {values}, 1 << 20);
+    });
+
+    run("GpuPrimitives::sortKeyValue(1M)", iterations / 100, [&](std::size_t)
+    {
+        primitives.sortKeyValue({keys}, {values}, 1 << 20);
+    });
+
+    GL::SamplerCache sampler_cache;
+    std::array<GL::SamplerDescription, 4> sampler_descriptions;
+    for (std::size_t i = 0; i < sampler_descriptions.size(); i++)
+        sampler_descriptions[i].lod_bias = float(i);
+
+    run("SamplerCache::get", iterations, [&](std::size_t i)
+    {
+        (void) sampler_cache.get(sampler_descriptions[i % sampler_descriptions.size()]);
+    });
+
+    std::array<GL::Texture, 8> textures{GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d),
+                                        GL::Texture(GL::TextureHandle::Type::_2d)};
+
+    // a material switch which keeps six of the eight textures
+    run("TextureHandle::bindTextureUnit(8)", iterations, [&](std::size_t i)
+    {
+        for (GLuint unit = 0; unit < textures.size(); unit++)
+            GL::TextureHandle::bindTextureUnit(unit, textures[unit < 6 ? unit : (unit + i) % textures.size()]);
+    });
+
+    GL::TextureBindingTracker binding_tracker;
+    run("TextureBindingTracker::flush(8)", iterations, [&](std::size_t i)
+    {
+        for (GLuint unit = 0; unit < textures.size(); unit++)
+            binding_tracker.setTexture(unit, textures[unit < 6 ? unit : (unit + i) % textures.size()]);
+        binding_tracker.flush();
+    });
+
+    // continuous 4K capture, three frames in flight
+    GL::TextureReadback readback(3 * 3840 * 2160 * 4);
+    run("TextureReadback::request(3840x2160)", iterations, [&](std::size_t)
+    {
+        (void) readback.request(textures[0], 0, 0, 0, 0, 3840, 2160, 1, GL::TextureHandle::DataFormat::rgba,
+                                GL::TextureHandle::DataType::ubyte);
+        for (const auto &frame: readback.poll())
+            readback.release(frame.id);
+    });
+
+    runBlockCompression("compressBlocks(bc1, 1024x1024)", GL::BlockFormat::bc1, 3);
+    runBlockCompression("compressBlocks(bc4, 1024x1024)", GL::BlockFormat::bc4, 1);
+    runBlockCompression("compressBlocks(bc5, 1024x1024)", GL::BlockFormat::bc5, 2);
+    runBlockCompression("compressBlocks(bc7, 1024x1024)", GL::BlockFormat::bc7, 4);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#ifndef GLUTILS_BARRIER_TRACKER_HPP
+#define GLUTILS_BARRIER_TRACKER_HPP
+
+#include "buffer.hpp"
+#include "texture.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace GL {
+
+/// Issues the glMemoryBarrier() bits needed to read what shaders wrote, instead of GL_ALL_BARRIER_BITS.
+/**
+ * Writes made by shaders through shader storage blocks, image stores and atomic counters are incoherent: other
+ * commands only see them after a barrier with the bit of the way they access the memory. The tracker records which
+ * buffers and textures were written that way and, when one of them is about to be used, adds the bit for that use
+ * to a pending set unless a barrier with that bit was issued after the write. flush() issues the pending bits with a
+ * single call.
+ *
+ * A typical frame records the writes of each dispatch, records the uses of the next draw or dispatch, then flushes
+ * right before issuing it. A shader that writes memory another shader wrote earlier must use() it with
+ * Access::shader_storage or Access::shader_image_access first.
+ *
+ * Objects are identified by name, so a name reused after its object was deleted may cause one unneeded barrier.
+ */
+class BarrierTracker
+{
+public:
+    /// Ways to access memory written by shaders, as their glMemoryBarrier() bits.
+    enum class Access : GLbitfield
+    {
+        vertex_attrib_array = 0x00000001,
+        element_array = 0x00000002,
+        uniform = 0x00000004,
+        texture_fetch = 0x00000008,
+        shader_image_access = 0x00000020,
+        command = 0x00000040,
+        pixel_buffer = 0x00000080,
+        texture_update = 0x00000100,
+        buffer_update = 0x00000200,
+        framebuffer = 0x00000400,
+        transform_feedback = 0x00000800,
+        atomic_counter = 0x00001000,
+        shader_storage = 0x00002000,
+        client_mapped_buffer = 0x00004000,
+        query_buffer = 0x00008000,
+    };
+
+    /// Record that a shader wrote @p buffer through a shader storage block, an image or an atomic counter.
+    /**
+     * Call it after issuing the draw or dispatch that writes, so that a barrier flushed before that command isn't
+     * taken to cover its writes.
+     */
+    void write(BufferHandle buffer);
+
+    /// Record that a shader wrote @p texture through an image. @see write(BufferHandle)
+    void write(TextureHandle texture);
+
+    /// Record that @p buffer is about to be accessed in the ways given by @p access.
+    void use(BufferHandle buffer, Access access);
+
+    /// Record that @p texture is about to be accessed in the ways given by @p access.
+    void use(TextureHandle texture, Access access);
+
+    /// Issue the pending barrier bits, if any.
+    void flush();
+
+    /// Barrier bits flush() would issue.
+    [[nodiscard]]
+    auto getPendingBits() const -> GLbitfield
+    { return m_pending; }
+
+    /// Number of glMemoryBarrier() calls made.
+    [[nodiscard]]
+    auto getIssuedCount() const -> std::size_t
+    { return m_issued_count; }
+
+    /// Number of calls to use() which didn't need any new barrier bit.
+    [[nodiscard]]
+    auto getElidedCount() const -> std::size_t
+    { return m_elided_count; }
+
+    void resetCounters()
+    {
+        m_issued_count = 0;
+        m_elided_count = 0;
+    }
+
+    /// Forget all recorded writes, e.g. after a glFinish() or a barrier issued elsewhere.
+    void clear();
+
+private:
+    static constexpr std::size_t s_bit_count = 16;
+
+    void write(std::uint64_t key);
+
+    void use(std::uint64_t key, GLbitfield access);
+
+    // serial number of the last write to each object, counting from 1
+    std::unordered_map<std::uint64_t, std::uint64_t> m_writes;
+    std::uint64_t m_serial{0};
+
+    // for each barrier bit, the serial number of the last write issued before the last barrier with that bit
+    std::array<std::uint64_t, s_bit_count> m_synced{};
+
+    GLbitfield m_pending{0};
+    std::size_t m_issued_count{0};
+    std::size_t m_elided_count{0};
+};
+
+auto operator|(BarrierTracker::Access l, BarrierTracker::Access r) -> BarrierTracker::Access;
+
+} // GL
+
+#endif //GLUTILS_BARRIER_TRACKER_HPP
@@ -0,0 +1,170 @@
+#ifndef GLUTILS_BINDLESS_TEXTURE_MANAGER_HPP
+#define GLUTILS_BINDLESS_TEXTURE_MANAGER_HPP
+
+#include "buffer.hpp"
+#include "sampler.hpp"
+#include "texture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace GL {
+
+/// Makes many textures accessible to shaders through a table of texture handles in a shader storage buffer.
+/**
+ * With GL_ARB_bindless_texture, each texture added gets a slot holding its 64-bit texture handle. Shaders index the
+ * table and construct a sampler from the handle:
+ *
+ *     layout(std430, binding = 0) readonly buffer Textures { uvec2 textures[]; };
+ *     vec4 color = texture(sampler2D(textures[slot]), uv);
+ *
+ * A handle may only be used while it is resident. use() makes a texture resident and keeps the resident set under a
+ * byte budget by making the least recently used textures non-resident again, except those used since the last call
+ * to nextFrame().
+ *
+ * Without the extension, textures are copied into the layers of a 2D array texture instead, and the first component
+ * of a slot holds the layer of its texture while the texture is resident, and non_resident_layer otherwise:
+ *
+ *     layout(binding = 0) uniform sampler2DArray texture_array;
+ *     vec4 color = texture(texture_array, vec3(uv, textures[slot].x));
+ *
+ * Then the budget is the number of layers of the array, and every texture must match its format and size.
+ */
+class BindlessTextureManager
+{
+public:
+    /// Table entry of a slot whose texture isn't in the fallback array.
+    static constexpr GLuint64 non_resident_layer = 0xFFFFFFFF;
+
+    /// The array textures are copied into when GL_ARB_bindless_texture isn't supported.
+    struct ArrayFallback
+    {
+        TextureHandle::SizedInternalFormat format{TextureHandle::SizedInternalFormat::rgba8};
+        GLsizei width{0};
+        GLsizei height{0};
+        GLsizei levels{1};
+        GLsizei layers{0};
+    };
+
+    /// @param budget total size in bytes of the textures that may be resident at once. Ignored by the fallback.
+    /// @param capacity number of slots of the table.
+    /// @param fallback used, and the array texture created, only if GL_ARB_bindless_texture isn't supported.
+    BindlessTextureManager(GLsizeiptr budget, GLuint capacity, const ArrayFallback &fallback);
+
+    ~BindlessTextureManager();
+
+    BindlessTextureManager(const BindlessTextureManager &) = delete;
+
+    BindlessTextureManager &operator=(const BindlessTextureManager &) = delete;
+
+    /// True if textures are accessed through GL_ARB_bindless_texture handles rather than the fallback array.
+    [[nodiscard]]
+    bool isBindless() const
+    { return m_bindless; }
+
+    /// Add @p texture to the table. It isn't resident until use() is called.
+    /**
+     * Getting a handle makes the state of the texture (and the sampler) immutable.
+     * @param size size of the texture in bytes, counted against the budget.
+     * @param sampler sampler whose state replaces the texture's own, or a zero handle. Ignored by the fallback.
+     * @return the slot of the texture.
+     * @throw GL::Error if all slots are in use.
+     */
+    auto add(TextureHandle texture, GLsizeiptr size, SamplerHandle sampler = {}) -> GLuint;
+
+    /// Make the texture in @p slot non-resident and free the slot.
+    /**
+     * @throw GL::Error if @p slot is out of range.
+     */
+    void remove(GLuint slot);
+
+    /// Make the texture in @p slot resident if it isn't already, and mark it used in the current frame.
+    /**
+     * If the resident textures exceed the budget, the least recently used ones which weren't used in the current frame
+     * are made non-resident. The budget may be exceeded if all resident textures were used in the current frame.
+     * @throw GL::Error if @p slot holds no texture, or with the fallback, if all layers of the array are taken by
+     * textures used in the current frame.
+     */
+    void use(GLuint slot);
+
+    /// Start a new frame: textures used before may be evicted again.
+    void nextFrame()
+    { m_frame++; }
+
+    /// Upload the slots changed since the last call to the table.
+    void flush();
+
+    /// The table of handles, one uvec2 per slot. Call flush() before using it.
+    [[nodiscard]]
+    auto getBuffer() const -> BufferHandle
+    { return m_table; }
+
+    /// The fallback array texture, or a zero handle if textures are bindless.
+    [[nodiscard]]
+    auto getArray() const -> TextureHandle
+    { return m_array; }
+
+    [[nodiscard]]
+    auto getResidentCount() const -> std::size_t
+    { return m_lru.size(); }
+
+    /// Bytes of resident textures, or the number of layers taken with the fallback.
+    [[nodiscard]]
+    auto getResidentSize() const -> GLsizeiptr
+    { return m_resident_size; }
+
+    /// Number of times a texture was made non-resident to stay under the budget.
+    [[nodiscard]]
+    auto getEvictionCount() const -> std::size_t
+    { return m_eviction_count; }
+
+private:
+    struct Slot
+    {
+        TextureHandle texture;
+        GLsizeiptr size{0};
+        GLuint64 handle{0};
+        bool used{false};
+        bool resident{false};
+        std::uint64_t last_frame{0};
+        GLint layer{-1};
+        std::list<GLuint>::iterator lru;
+    };
+
+    void makeResident(GLuint slot);
+
+    void makeNonResident(GLuint slot);
+
+    void setEntry(GLuint slot, GLuint64 value);
+
+    bool m_bindless{false};
+    GLsizeiptr m_budget;
+    std::vector<Slot> m_slots;
+    std::vector<GLuint> m_free_slots;
+
+    // resident slots, most recently used first
+    std::list<GLuint> m_lru;
+    GLsizeiptr m_resident_size{0};
+    std::uint64_t m_frame{1};
+    std::size_t m_eviction_count{0};
+
+    ArrayFallback m_fallback;
+    Texture m_array{TextureHandle{}};
+    std::vector<GLint> m_free_layers;
+
+    Buffer m_table;
+    std::vector<GLuint64> m_entries;
+    GLuint m_dirty_begin{0};
+    GLuint m_dirty_end{0};
+
+    // GL_ARB_bindless_texture entry points
+    struct Procs;
+    std::unique_ptr<Procs> m_procs;
+};
+
+} // GL
+
+#endif //GLUTILS_BINDLESS_TEXTURE_MANAGER_HPP
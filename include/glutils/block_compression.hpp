@@ -0,0 +1,63 @@
+#ifndef GLUTILS_BLOCK_COMPRESSION_HPP
+#define GLUTILS_BLOCK_COMPRESSION_HPP
+
+#include "texture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GL {
+
+/// Block-compressed formats produced by compressBlocks().
+enum class BlockFormat
+{
+    /// RGB, 8 bytes per block; GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+    bc1,
+    /// red channel, 8 bytes per block; GL_COMPRESSED_RED_RGTC1
+    bc4,
+    /// red and green channels, 16 bytes per block; GL_COMPRESSED_RG_RGTC2
+    bc5,
+    /// RGBA, 16 bytes per block; GL_COMPRESSED_RGBA_BPTC_UNORM. Only mode 6 is produced.
+    bc7,
+};
+
+/// The internal format to create textures of @p format with.
+[[nodiscard]]
+auto getInternalFormat(BlockFormat format) -> TextureHandle::SizedInternalFormat;
+
+/// Size in bytes of the blocks of a @p width x @p height image in @p format.
+[[nodiscard]]
+auto getCompressedSize(BlockFormat format, GLsizei width, GLsizei height) -> std::size_t;
+
+/// Compress an RGBA8 image on the CPU.
+/**
+ * Endpoints are fitted along the principal axis of the colors of each block, and the pixels are then projected onto
+ * the segment between them; the projections are vectorized with AVX2 or SSE2 when the compiler targets them. The
+ * blocks are split between @p threads threads by rows.
+ *
+ * Blocks which extend past the edges of the image repeat its last row and column.
+ * @param pixels @p width x @p height RGBA pixels with tightly packed rows.
+ * @param blocks getCompressedSize() bytes, which can be uploaded with TextureHandle::updateCompressedImage2D().
+ * @param threads number of threads to use, or 0 for std::thread::hardware_concurrency().
+ */
+void compressBlocks(BlockFormat format, const std::uint8_t *pixels, GLsizei width, GLsizei height,
+                    std::uint8_t *blocks, unsigned threads = 0);
+
+/// @copydoc compressBlocks
+[[nodiscard]]
+auto compressBlocks(BlockFormat format, const std::uint8_t *pixels, GLsizei width, GLsizei height,
+                    unsigned threads = 0) -> std::vector<std::uint8_t>;
+
+/// Decompress blocks into an RGBA8 image, as a texture of getInternalFormat() would be sampled.
+/**
+ * A reference decoder to validate compressBlocks() with: missing channels are 0, and alpha is 255 unless the format
+ * has it. BC7 blocks of modes other than 6 decode to zero.
+ * @param pixels @p width x @p height RGBA pixels with tightly packed rows.
+ */
+void decompressBlocks(BlockFormat format, const std::uint8_t *blocks, GLsizei width, GLsizei height,
+                      std::uint8_t *pixels);
+
+} // GL
+
+#endif //GLUTILS_BLOCK_COMPRESSION_HPP
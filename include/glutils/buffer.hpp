@@ -171,6 +171,8 @@ public:
         map_persistent = 0x0040,
         map_coherent = 0x0080,
         client_storage = 0x0200,
+        /// GL_SPARSE_STORAGE_BIT_ARB, requires GL_ARB_sparse_buffer
+        sparse_storage = 0x0400,
     };
 
     /// Query the GL_BUFFER_STORAGE_FLAGS parameter.
@@ -16,8 +16,17 @@
 namespace GL {
 
 /// Initializes glutils for the context that's current on the calling thread. Returns the version number of the context.
+/**
+ * Also queries the context's limits and extensions, which are then available through getLimits().
+ */
 int loadContext(GLADloadfunc loader);
 
+/// Load a function outside of OpenGL 4.6 core, such as an extension function, with the loader given to loadContext().
+/**
+ * @return a pointer to the function, or null if the loader doesn't provide it.
+ */
+auto getProcAddress(const char *name) -> GLADapiproc;
+
 #if GLUTILS_DEBUG
 
 /**
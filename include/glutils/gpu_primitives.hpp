@@ -0,0 +1,155 @@
+#ifndef GLUTILS_GPU_PRIMITIVES_HPP
+#define GLUTILS_GPU_PRIMITIVES_HPP
+
+#include "buffer.hpp"
+#include "program.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GL {
+
+/// Parallel scan, reduction, radix sort and stream compaction on arrays stored in buffers.
+/**
+ * Each operation runs compute kernels which use work-group shared memory. Kernels are generated on first use for
+ * each combination of operation and value type, and kept until clear() is called. Temporary storage is allocated
+ * on demand and reused by later calls.
+ *
+ * Every operation changes the current program and the shader storage buffer bindings 0 to 4.
+ * GL_SHADER_STORAGE_BARRIER_BIT barriers are issued between the passes of an operation, but not before the first
+ * one or after the last one: the caller is responsible for the barriers its own writes to the inputs and reads of
+ * the results require.
+ */
+class GpuPrimitives
+{
+public:
+    /// Type of the elements of the arrays. Elements are tightly packed, four bytes each.
+    enum class ValueType
+    {
+        uint32,
+        int32,
+        float32,
+    };
+
+    enum class ReduceOp
+    {
+        sum,
+        min,
+        max,
+    };
+
+    /// An array starting @p offset bytes into @p buffer. The offset must be a multiple of four.
+    struct Array
+    {
+        BufferHandle buffer;
+        GLintptr offset{0};
+    };
+
+    /// @param work_group_size invocations per work group of every kernel; a power of two of at least 16. Each
+    /// invocation processes four elements.
+    /// @throw GL::Error if @p work_group_size is invalid, or exceeds the compute work group or shared memory limits.
+    /// The radix sort kernel needs 32 bytes of shared memory per invocation, so 1024 exceeds the minimum limit.
+    explicit GpuPrimitives(GLuint work_group_size = 256);
+
+    /// Write the exclusive prefix sum of the @p count elements of @p input to @p output.
+    /**
+     * @p input and @p output may be the same array.
+     * @throw GL::Error if a kernel fails to build or @p count exceeds the dispatch limits.
+     */
+    void exclusiveScan(Array input, Array output, GLuint count, ValueType type = ValueType::uint32);
+
+    /// Write the inclusive prefix sum of the @p count elements of @p input to @p output.
+    /// @copydetails exclusiveScan
+    void inclusiveScan(Array input, Array output, GLuint count, ValueType type = ValueType::uint32);
+
+    /// Combine the @p count elements of @p input with @p op and write the result to the first element of @p output.
+    /**
+     * If @p count is zero, the identity of @p op is written.
+     * @throw GL::Error if a kernel fails to build or @p count exceeds the dispatch limits.
+     */
+    void reduce(Array input, Array output, GLuint count, ReduceOp op, ValueType type = ValueType::uint32);
+
+    /// Sort the @p count 32-bit unsigned keys of @p keys in place, in ascending order.
+    /**
+     * This is a stable least-significant-digit radix sort of four bits per pass.
+     * @param key_bits number of low bits of the keys to sort by. Bits above are ignored, and fewer bits need fewer
+     * passes.
+     * @throw GL::Error if a kernel fails to build or @p count exceeds the dispatch limits.
+     */
+    void sort(Array keys, GLuint count, GLuint key_bits = 32);
+
+    /// Sort the @p count 32-bit unsigned keys of @p keys in place and reorder the 32-bit @p values the same way.
+    /// @copydetails sort
+    void sortKeyValue(Array keys, Array values, GLuint count, GLuint key_bits = 32);
+
+    /// Copy the 32-bit elements of @p input whose flag is non-zero to @p output, preserving their order.
+    /**
+     * @param flags one 32-bit unsigned flag per element of @p input.
+     * @param output_count receives the number of elements written to @p output, as a 32-bit unsigned integer, so it
+     * can be used as a parameter of an indirect draw or dispatch.
+     * @throw GL::Error if a kernel fails to build or @p count exceeds the dispatch limits.
+     */
+    void compact(Array input, Array flags, Array output, Array output_count, GLuint count);
+
+    /// Number of elements processed by each work group.
+    [[nodiscard]]
+    auto getBlockSize() const -> GLuint
+    { return m_work_group_size * s_items_per_invocation; }
+
+    /// Number of kernels built so far.
+    [[nodiscard]]
+    auto getProgramCount() const -> std::size_t
+    { return m_programs.size(); }
+
+    /// Destroy all kernels and temporary storage.
+    void clear();
+
+private:
+    static constexpr GLuint s_items_per_invocation = 4;
+
+    enum class Kernel
+    {
+        scan,
+        scan_add,
+        reduce,
+        radix_histogram,
+        radix_scatter,
+        compact_scatter,
+    };
+
+    // temporary storage which only grows
+    struct Scratch
+    {
+        Buffer buffer{BufferHandle{}};
+        GLsizeiptr size{0};
+    };
+
+    auto getProgram(Kernel kernel, ValueType type, GLuint variant = 0) -> ProgramHandle;
+
+    auto getScratch(Scratch &scratch, GLsizeiptr size) -> BufferHandle;
+
+    auto getGroupCount(GLuint count) const -> GLuint;
+
+    void scan(Array input, Array output, GLuint count, ValueType type, bool inclusive, bool predicate,
+              std::size_t level);
+
+    void radixSort(Array keys, const Array *values, GLuint count, GLuint key_bits);
+
+    GLuint m_work_group_size;
+
+    std::unordered_map<std::uint64_t, Program> m_programs;
+
+    std::vector<Scratch> m_scan_sums;
+    Scratch m_reduce[2];
+    Scratch m_histogram;
+    Scratch m_keys;
+    Scratch m_values;
+    Scratch m_indices;
+};
+
+} // GL
+
+#endif //GLUTILS_GPU_PRIMITIVES_HPP
@@ -0,0 +1,34 @@
+#ifndef GLUTILS_HASH_HPP
+#define GLUTILS_HASH_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace GL {
+
+/// 64-bit FNV-1a hash. Usable in constant expressions, so names can be hashed at compile time.
+constexpr auto hash(std::string_view string, std::uint64_t seed = 0xcbf29ce484222325) -> std::uint64_t
+{
+    std::uint64_t value = seed;
+    for (const char c: string)
+    {
+        value ^= static_cast<unsigned char>(c);
+        value *= 0x100000001b3;
+    }
+    return value;
+}
+
+/// Combine a hash with an integer value.
+constexpr auto hash(std::uint64_t value, std::uint64_t seed) -> std::uint64_t
+{
+    for (int i = 0; i < 8; i++)
+    {
+        seed ^= (value >> (i * 8)) & 0xff;
+        seed *= 0x100000001b3;
+    }
+    return seed;
+}
+
+} // GL
+
+#endif //GLUTILS_HASH_HPP
@@ -0,0 +1,90 @@
+#ifndef GLUTILS_LIMITS_HPP
+#define GLUTILS_LIMITS_HPP
+
+#include "gl_types.hpp"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GL {
+
+/// Implementation limits and capabilities of an OpenGL context.
+/**
+ * Queried once by loadContext(), so that reading a limit never reaches the driver. Values are the ones reported
+ * by glGetIntegerv, glGetInteger64v, glGetIntegeri_v and glGetFloatv for the corresponding GL_MAX_* enum.
+ */
+struct Limits
+{
+    // indexed buffer bindings
+    GLint max_uniform_buffer_bindings{0};
+    GLint max_shader_storage_buffer_bindings{0};
+    GLint max_atomic_counter_buffer_bindings{0};
+    GLint max_transform_feedback_buffers{0};
+
+    // buffer alignments, in bytes
+    GLint uniform_buffer_offset_alignment{1};
+    GLint shader_storage_buffer_offset_alignment{1};
+    GLint min_map_buffer_alignment{1};
+
+    // block sizes, in bytes
+    GLint64 max_uniform_block_size{0};
+    GLint64 max_shader_storage_block_size{0};
+
+    // textures
+    GLint max_texture_size{0};
+    GLint max_3d_texture_size{0};
+    GLint max_cube_map_texture_size{0};
+    GLint max_array_texture_layers{0};
+    GLint max_texture_buffer_size{0};
+    GLint max_texture_image_units{0};
+    GLint max_combined_texture_image_units{0};
+    GLint max_image_units{0};
+    GLfloat max_texture_max_anisotropy{1.0f};
+    GLfloat max_texture_lod_bias{0.0f};
+
+    // vertex input
+    GLint max_vertex_attribs{0};
+    GLint max_vertex_attrib_bindings{0};
+
+    // framebuffers
+    GLint max_color_attachments{0};
+    GLint max_draw_buffers{0};
+    GLint max_samples{0};
+
+    // compute
+    std::array<GLint, 3> max_compute_work_group_count{};
+    std::array<GLint, 3> max_compute_work_group_size{};
+    GLint max_compute_work_group_invocations{0};
+    GLint max_compute_shared_memory_size{0};
+
+    // binary formats
+    GLint num_program_binary_formats{0};
+    GLint num_shader_binary_formats{0};
+
+    // GL_VENDOR, GL_RENDERER, GL_VERSION and GL_SHADING_LANGUAGE_VERSION strings
+    std::string vendor;
+    std::string renderer;
+    std::string version;
+    std::string shading_language_version;
+
+    /// Names of the supported extensions, sorted.
+    std::vector<std::string> extensions;
+
+    /// Check if the extension @p name (e.g. "GL_ARB_bindless_texture") is supported.
+    [[nodiscard]]
+    bool hasExtension(std::string_view name) const;
+};
+
+/// Query the limits of the context that's current on the calling thread. Prefer getLimits(), which doesn't query.
+[[nodiscard]]
+auto queryLimits() -> Limits;
+
+/// Limits of the context loaded by the last call to loadContext().
+[[nodiscard]]
+auto getLimits() -> const Limits &;
+
+} // GL
+
+#endif //GLUTILS_LIMITS_HPP
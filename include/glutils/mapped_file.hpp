@@ -0,0 +1,49 @@
+#ifndef GLUTILS_MAPPED_FILE_HPP
+#define GLUTILS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace GL {
+
+/// A read-only memory mapping of a whole file, such as a SPIR-V module or a texture container.
+/**
+ * Only available on POSIX systems.
+ */
+class MappedFile
+{
+public:
+    /// Map the file at @p path.
+    /**
+     * @throw GL::Error if the file can't be opened or mapped.
+     */
+    explicit MappedFile(const std::string &path);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile &&other) noexcept;
+
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    [[nodiscard]]
+    auto data() const -> const unsigned char *
+    { return static_cast<const unsigned char *>(m_data); }
+
+    [[nodiscard]]
+    auto size() const -> std::size_t
+    { return m_size; }
+
+private:
+    void unmap();
+
+    void *m_data{nullptr};
+    std::size_t m_size{0};
+};
+
+} // GL
+
+#endif //GLUTILS_MAPPED_FILE_HPP
@@ -0,0 +1,43 @@
+#ifndef GLUTILS_NULL_CONTEXT_HPP
+#define GLUTILS_NULL_CONTEXT_HPP
+
+#include "gl.hpp"
+
+#include <cstddef>
+
+/// A null OpenGL 4.6 backend that doesn't render anything, for measuring glutils without a driver or a GPU.
+namespace GL::Null {
+
+/// Function loader for the null context. Use it as GL::loadContext(GL::Null::getProcAddress).
+/**
+ * Every function only records that it was called. Object creation, buffer storage and mapping, and the queries
+ * glutils relies on return plausible values; other functions return zero or nullptr, and other queries leave their
+ * output arguments untouched. The null context supports no extension functions.
+ * @param name name of the OpenGL function.
+ * @return a pointer to the null implementation of the function, or nullptr if it isn't an OpenGL 4.6 function.
+ */
+auto getProcAddress(const char *name) -> GLADapiproc;
+
+/// Number of times the function @p name has been called since the last call to resetCallCounts().
+[[nodiscard]]
+auto getCallCount(const char *name) -> std::size_t;
+
+/// Number of calls made to any function since the last call to resetCallCounts().
+[[nodiscard]]
+auto getTotalCallCount() -> std::size_t;
+
+/// Set all call counters back to zero.
+void resetCallCounts();
+
+/// Enable or disable argument validation.
+/**
+ * While enabled, object names passed to functions which create, delete, query or map buffers, textures, vertex arrays,
+ * shaders, programs, program pipelines, transform feedback objects and samplers are checked against the set of live
+ * objects, and a GL::Error is thrown on mismatch.
+ * Disabled by default, since validation adds lookups that are not part of the cost being measured.
+ */
+void setValidation(bool enabled);
+
+} // GL::Null
+
+#endif //GLUTILS_NULL_CONTEXT_HPP
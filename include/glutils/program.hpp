@@ -1,12 +1,15 @@
 #ifndef SIMPLERENDERER_PROGRAM_HPP
 #define SIMPLERENDERER_PROGRAM_HPP
 
+#include "buffer.hpp"
 #include "handle.hpp"
 #include "shader.hpp"
 #include "object.hpp"
 
 #include "glm/gtc/type_ptr.hpp"
 
+#include <array>
+#include <initializer_list>
 #include <type_traits>
 
 namespace GL {
@@ -19,12 +22,46 @@ public:
 
     static void destroy(ProgramHandle program);
 
+    /// glCreateShaderProgramv — create a stand-alone, separable program from an array of null-terminated source code strings. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glCreateShaderProgram.xhtml
+    /**
+     * The program is compiled and linked in one go. Check Parameter::link_status and getInfoLog() for errors.
+     */
+    static auto createSeparable(ShaderHandle::Type type, GLsizei count, const GLchar *const *strings) -> ProgramHandle;
+
+    /// createSeparable overload taking an std::string.
+    static auto createSeparable(ShaderHandle::Type type, const std::string &source) -> ProgramHandle
+    {
+        const GLchar *string = source.c_str();
+        return createSeparable(type, 1, &string);
+    }
+
     /// Installs a program object as part of current rendering state. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glUseProgram.xhtml
     void use() const;
 
     /// glLinkProgram - Links a program object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glLinkProgram.xhtml
     void link() const;
 
+    enum class TransformFeedbackBufferMode : GLenum
+    {
+        interleaved_attribs = 0x8C8C,
+        separate_attribs = 0x8C8D,
+    };
+
+    /// glTransformFeedbackVaryings — specify values to record in transform feedback buffers. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glTransformFeedbackVaryings.xhtml
+    /**
+     * Takes effect on the next link(). With interleaved_attribs, "gl_NextBuffer" moves to the next buffer binding and
+     * "gl_SkipComponents1" to "gl_SkipComponents4" leave gaps.
+     */
+    void setTransformFeedbackVaryings(GLsizei count, const GLchar *const *varyings,
+                                      TransformFeedbackBufferMode buffer_mode) const;
+
+    /// setTransformFeedbackVaryings overload taking a list of names.
+    void setTransformFeedbackVaryings(std::initializer_list<const GLchar *> varyings,
+                                      TransformFeedbackBufferMode buffer_mode) const
+    {
+        setTransformFeedbackVaryings(static_cast<GLsizei>(varyings.size()), varyings.begin(), buffer_mode);
+    }
+
     /// assign a binding point to an active uniform block. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glUniformBlockBinding.xhtml
     void setUniformBlockBinding(GLuint block_index, GLuint binding) const;
 
@@ -67,13 +104,85 @@ public:
         transform_feedback_varying_max_length = 0x8C76,
         geometry_vertices_out = 0x8916,
         geometry_input_type = 0x8917,
-        geometry_output_type = 0x8918
+        geometry_output_type = 0x8918,
+        program_binary_retrievable_hint = 0x8257,
+        program_separable = 0x8258,
+        /// requires GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile
+        completion_status = 0x91B1
     };
 
     /// https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetProgramInfoLog.xhtml
+    /**
+     * For Parameter::compute_work_group_size only the x component is returned; use getComputeWorkGroupSize().
+     */
     [[nodiscard]]
     auto getParameter(Parameter parameter) const -> GLint;
 
+    /// The local size (local_size_x, local_size_y, local_size_z) of a linked compute program.
+    [[nodiscard]]
+    auto getComputeWorkGroupSize() const -> std::array<GLint, 3>;
+
+    /// Number of work groups needed to cover @p problem_size invocations with groups of @p local_size, rounding up.
+    [[nodiscard]]
+    static constexpr auto getGroupCount(std::array<GLuint, 3> problem_size, std::array<GLint, 3> local_size)
+    -> std::array<GLuint, 3>
+    {
+        std::array<GLuint, 3> count{};
+        for (std::size_t i = 0; i < count.size(); i++)
+        {
+            const auto size = static_cast<GLuint>(local_size[i] > 0 ? local_size[i] : 1);
+            // rather than (problem + size - 1) / size, which wraps for problem sizes close to the maximum
+            count[i] = problem_size[i] / size + (problem_size[i] % size != 0);
+        }
+        return count;
+    }
+
+    /// getGroupCount() with the local size of this program. Queries the program, so consider caching the result.
+    [[nodiscard]]
+    auto getGroupCount(std::array<GLuint, 3> problem_size) const -> std::array<GLuint, 3>
+    {
+        return getGroupCount(problem_size, getComputeWorkGroupSize());
+    }
+
+    /// glDispatchCompute — launch one or more compute work groups. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDispatchCompute.xhtml
+    /**
+     * Runs the compute program installed with use().
+     */
+    static void dispatchCompute(GLuint num_groups_x, GLuint num_groups_y = 1, GLuint num_groups_z = 1);
+
+    static void dispatchCompute(std::array<GLuint, 3> num_groups)
+    {
+        dispatchCompute(num_groups[0], num_groups[1], num_groups[2]);
+    }
+
+    /// Layout of the arguments read by dispatchComputeIndirect().
+    struct DispatchIndirectCommand
+    {
+        GLuint num_groups_x{1};
+        GLuint num_groups_y{1};
+        GLuint num_groups_z{1};
+    };
+
+    /// glDispatchComputeIndirect — launch one or more compute work groups using parameters stored in a buffer. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDispatchComputeIndirect.xhtml
+    /**
+     * Runs the compute program installed with use(). Binds @p buffer to GL_DISPATCH_INDIRECT_BUFFER.
+     * @param buffer buffer holding DispatchIndirectCommand structures.
+     * @param offset byte offset of the command within @p buffer; must be a multiple of four.
+     */
+    static void dispatchComputeIndirect(BufferHandle buffer, GLintptr offset = 0);
+
+    /// glProgramParameteri - specify a parameter for a program object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glProgramParameter.xhtml
+    /**
+     * Only Parameter::program_binary_retrievable_hint and Parameter::program_separable may be set.
+     */
+    void setParameter(Parameter parameter, GLint value) const;
+
+    /// glGetProgramBinary - return a binary representation of a program object's compiled and linked executable source. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetProgramBinary.xhtml
+    void getBinary(GLsizei buf_size, GLsizei *length, GLenum *binary_format, void *binary) const;
+
+    /// glProgramBinary - load a program object with a program binary. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glProgramBinary.xhtml
+    void setBinary(GLenum binary_format, const void *binary, GLsizei length) const;
+
     /// https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetProgramInfoLog.xhtml
     void getInfoLog(GLsizei max_length, GLsizei *length, GLchar *info_log) const;
 
@@ -129,7 +238,7 @@ public:
     auto getResourceLocationIndex(Interface interface, const char *name) const -> GLint;
 
     /// query the name of an indexed resource within a program. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetProgramResourceName.xhtml
-    auto getResourceName(Interface interface, GLuint index, GLsizei buf_size, GLsizei *length, char *name) const;
+    void getResourceName(Interface interface, GLuint index, GLsizei buf_size, GLsizei *length, char *name) const;
 
     /**
      * @brief glProgramUniform - Specify the value of a uniform variable for a specified program object
@@ -159,16 +268,23 @@ private:
     template<class R, class... Ps>
     using GLProc = R (*)(Ps...);
 
+    // The tables below hold the addresses of glad's function pointers, which are only set by loadContext().
+    template<class Proc>
+    static auto s_glCall(Proc *proc) -> Proc
+    {
+        return *proc;
+    }
+
     // glProgramUniformNT
     template<class... Params> using GLProgramUniformProc = GLProc<void, GLuint, GLint, Params...>;
 
     template<class T>
     struct GLProgramUniformFunctions
     {
-        GLProgramUniformProc<T> _1;
-        GLProgramUniformProc<T, T> _2;
-        GLProgramUniformProc<T, T, T> _3;
-        GLProgramUniformProc<T, T, T, T> _4;
+        GLProgramUniformProc<T> *_1;
+        GLProgramUniformProc<T, T> *_2;
+        GLProgramUniformProc<T, T, T> *_3;
+        GLProgramUniformProc<T, T, T, T> *_4;
     };
 
     template<class T>
@@ -187,7 +303,7 @@ private:
     template<class T>
     struct GLProgramUniformvFunctions
     {
-        GLProgramUniformvProc<T> values[4];
+        GLProgramUniformvProc<T> *values[4];
     };
 
     template<class T> static const GLProgramUniformvFunctions<T> s_program_uniform_v_functions{};
@@ -205,7 +321,7 @@ private:
     template<class T>
     struct GLProgramUniformMatrixFunctions
     {
-        GLProgramUniformMatrixProc<T> values[3][3];
+        GLProgramUniformMatrixProc<T> *values[3][3];
     };
 
     template<class T> static const GLProgramUniformMatrixFunctions<T> s_program_uniform_matrix_functions;
@@ -217,7 +333,7 @@ private:
         static_assert(C > 1 && C < 5 && R > 1 && R < 5, "C and R may only be 2, 3 or 4");
 
         s_glCall(s_program_uniform_matrix_functions<T>.values[C - 2][R - 2])(program, location, count, transpose,
-                                                                             glm::value_ptr(values));
+                                                                             glm::value_ptr(*values));
     }
 };
 
@@ -0,0 +1,102 @@
+#ifndef GLUTILS_PROGRAM_CACHE_HPP
+#define GLUTILS_PROGRAM_CACHE_HPP
+
+#include "program.hpp"
+#include "shader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GL {
+
+/// A persistent cache of program binaries, stored in a memory-mapped file.
+/**
+ * Programs are keyed by a hash of their shader sources and of the vendor, renderer and version strings of the
+ * context, so binaries are never loaded into a driver that didn't produce them.
+ *
+ * The file starts with a fixed-capacity open-addressing index of (key, offset, size, format) entries, followed by the
+ * binaries themselves. Access is synchronized with flock(), so several processes may share the same file. Entries are
+ * never removed, but a binary the driver rejects is replaced by the next one stored under its key; the rejected data
+ * stays in the file. Delete the file to clear the cache.
+ *
+ * Only available on POSIX systems.
+ */
+class ProgramCache
+{
+public:
+    /// Open the cache file at @p path, creating it with room for @p capacity programs if it doesn't exist.
+    /**
+     * @param path location of the cache file.
+     * @param capacity number of index entries to allocate when creating the file. Rounded up to a power of two.
+     * Ignored if the file already exists.
+     * @throw GL::Error if the file can't be opened, created or mapped, or isn't a valid cache file.
+     */
+    explicit ProgramCache(const std::string &path, std::uint32_t capacity = 1024);
+
+    ~ProgramCache();
+
+    ProgramCache(const ProgramCache &) = delete;
+
+    ProgramCache &operator=(const ProgramCache &) = delete;
+
+    /// Compute the cache key of a program made from @p sources, for the context loaded by loadContext().
+    [[nodiscard]]
+    static auto makeKey(const std::vector<ShaderSource> &sources) -> std::uint64_t;
+
+    /// Load the binary stored under @p key into @p program.
+    /**
+     * @return true if the binary was found and the driver accepted it, in which case @p program is linked.
+     */
+    bool load(ProgramHandle program, std::uint64_t key) const;
+
+    /// Retrieve the binary of the linked @p program and store it under @p key.
+    /**
+     * Set Parameter::program_binary_retrievable_hint to GL_TRUE before linking the program so the driver keeps the
+     * binary around.
+     * If a binary is already stored under @p key, it is replaced, since load() only fails on a stored key when the
+     * driver rejects its binary.
+     * @return false if the same binary was already stored, the index is full or the driver returned an empty binary.
+     */
+    bool store(ProgramHandle program, std::uint64_t key);
+
+    /// Link @p program from @p sources, or load it from the cache if it was linked before.
+    /**
+     * On a miss, shaders are created, compiled, attached and then detached and destroyed again, and the resulting
+     * binary is stored if linking succeeded.
+     * @return true if @p program is linked. If false, see the program's getInfoLog() and getShaderLog().
+     */
+    bool link(ProgramHandle program, const std::vector<ShaderSource> &sources);
+
+    /// Info logs of shaders that failed to compile during the last call to link().
+    [[nodiscard]]
+    auto getShaderLog() const -> const std::string &
+    { return m_shader_log; }
+
+    /// Number of programs stored in the cache file.
+    [[nodiscard]]
+    auto getEntryCount() const -> std::uint32_t;
+
+private:
+    struct Header;
+    struct Entry;
+
+    void remap(std::size_t size) const;
+
+    // map the data appended by other processes; false if the header points past the end of the file
+    [[nodiscard]] bool mapData() const;
+
+    [[nodiscard]] auto header() const -> Header &;
+
+    [[nodiscard]] auto entries() const -> Entry *;
+
+    int m_fd{-1};
+    mutable void *m_map{nullptr};
+    mutable std::size_t m_map_size{0};
+    std::string m_shader_log;
+};
+
+} // GL
+
+#endif //GLUTILS_PROGRAM_CACHE_HPP
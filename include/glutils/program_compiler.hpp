@@ -0,0 +1,122 @@
+#ifndef GLUTILS_PROGRAM_COMPILER_HPP
+#define GLUTILS_PROGRAM_COMPILER_HPP
+
+#include "program.hpp"
+#include "shader.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GL {
+
+/// Compiles and links many programs without blocking the thread that submits them.
+/**
+ * Programs are built in one of three ways, chosen when the compiler is constructed:
+ *  - If GL_KHR_parallel_shader_compile (or the ARB variant) is supported, compile and link commands are issued
+ *    immediately and the driver's compiler threads do the work. poll() checks GL_COMPLETION_STATUS_KHR, which
+ *    never blocks.
+ *  - Otherwise, if worker contexts are given, each one gets a thread that compiles and links submitted programs.
+ *  - Otherwise, programs are compiled and linked on the calling thread by submit().
+ *
+ * All member functions must be called from the thread the main context is current on.
+ */
+class ProgramCompiler
+{
+public:
+    /// Makes a context that shares objects with the main context current on the calling thread.
+    using MakeContextCurrent = std::function<void()>;
+
+    /// @param worker_contexts used only if parallel shader compilation isn't supported. One worker thread is created
+    /// for each element, which it calls before compiling anything.
+    explicit ProgramCompiler(std::vector<MakeContextCurrent> worker_contexts = {});
+
+    /// Stops the worker threads. Programs that are still pending are left as they are.
+    ~ProgramCompiler();
+
+    ProgramCompiler(const ProgramCompiler &) = delete;
+
+    ProgramCompiler &operator=(const ProgramCompiler &) = delete;
+
+    /// The outcome of building a program.
+    struct Result
+    {
+        ProgramHandle program;
+        bool linked{false};
+        /// the info logs of shaders which failed to compile, followed by the program's info log.
+        std::string info_log;
+    };
+
+    /// Compile @p sources and link them into @p program. The sources are copied if necessary.
+    void submit(ProgramHandle program, const std::vector<ShaderSource> &sources);
+
+    /// Retrieve the results of the programs that finished since the last call. Never blocks.
+    [[nodiscard]]
+    auto poll() -> std::vector<Result>;
+
+    /// Wait for @p program to finish and retrieve its result. Other programs are left for poll() or finish().
+    /**
+     * @throw GL::Error if @p program is not pending.
+     */
+    [[nodiscard]]
+    auto wait(ProgramHandle program) -> Result;
+
+    /// Wait for all submitted programs to finish and retrieve the results of those not yet returned by poll().
+    [[nodiscard]]
+    auto finish() -> std::vector<Result>;
+
+    /// Number of programs submitted but not yet returned by poll() or finish().
+    [[nodiscard]]
+    auto getPendingCount() const -> std::size_t
+    { return m_pending_count; }
+
+    /// True if the driver compiles in parallel through GL_KHR_parallel_shader_compile.
+    [[nodiscard]]
+    bool isDriverParallel() const
+    { return m_driver_parallel; }
+
+private:
+    struct OwnedShaderSource
+    {
+        ShaderHandle::Type type;
+        std::string source;
+    };
+
+    struct Job
+    {
+        ProgramHandle program;
+        std::vector<OwnedShaderSource> sources;
+        std::vector<Shader> shaders;
+    };
+
+    static void issue(Job &job, const std::vector<ShaderSource> &sources);
+
+    static auto complete(Job &job) -> Result;
+
+    void work(const MakeContextCurrent &make_current);
+
+    bool m_driver_parallel{false};
+    std::size_t m_pending_count{0};
+
+    // programs being compiled by the driver, or compiled synchronously
+    std::vector<Job> m_issued;
+
+    // worker threads
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_job_available;
+    std::condition_variable m_job_done;
+    std::deque<Job> m_queue;
+    std::vector<Result> m_done;
+    std::size_t m_in_progress{0};
+    bool m_stop{false};
+};
+
+} // GL
+
+#endif //GLUTILS_PROGRAM_COMPILER_HPP
@@ -0,0 +1,119 @@
+#ifndef GLUTILS_PROGRAM_PIPELINE_HPP
+#define GLUTILS_PROGRAM_PIPELINE_HPP
+
+#include "handle.hpp"
+#include "object.hpp"
+#include "program.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace GL {
+
+/// Wraps program pipeline objects, which combine the stages of separable programs.
+class ProgramPipelineHandle : public Handle
+{
+    using Handle::Handle;
+public:
+    static auto create() -> ProgramPipelineHandle;
+
+    static void destroy(ProgramPipelineHandle pipeline);
+
+    enum class Stages : GLbitfield
+    {
+        vertex = 0x00000001,
+        fragment = 0x00000002,
+        geometry = 0x00000004,
+        tess_control = 0x00000008,
+        tess_evaluation = 0x00000010,
+        compute = 0x00000020,
+        all = 0xFFFFFFFF
+    };
+
+    /// glBindProgramPipeline — bind a program pipeline to the current context. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBindProgramPipeline.xhtml
+    void bind() const;
+
+    /// glUseProgramStages — bind stages of a program object to a program pipeline. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glUseProgramStages.xhtml
+    /**
+     * @param stages the stages of @p program to use in the pipeline.
+     * @param program a separable program, or a zero handle to clear the stages.
+     */
+    void useProgramStages(Stages stages, ProgramHandle program) const;
+
+    /// glActiveShaderProgram — set the active program object for a program pipeline object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glActiveShaderProgram.xhtml
+    void setActiveProgram(ProgramHandle program) const;
+
+    /// glValidateProgramPipeline — validate a program pipeline object against current GL state. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glValidateProgramPipeline.xhtml
+    void validate() const;
+
+    enum class Parameter : GLenum
+    {
+        active_program = 0x8259,
+        vertex_shader = 0x8B31,
+        tess_control_shader = 0x8E88,
+        tess_evaluation_shader = 0x8E87,
+        geometry_shader = 0x8DD9,
+        fragment_shader = 0x8B30,
+        compute_shader = 0x91B9,
+        validate_status = 0x8B83,
+        info_log_length = 0x8B84
+    };
+
+    /// glGetProgramPipelineiv — retrieve properties of a program pipeline object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetProgramPipeline.xhtml
+    [[nodiscard]]
+    auto getParameter(Parameter parameter) const -> GLint;
+
+    [[nodiscard]] std::string getInfoLog() const;
+};
+
+using ProgramPipeline = Object<ProgramPipelineHandle>;
+
+auto operator|(ProgramPipelineHandle::Stages l, ProgramPipelineHandle::Stages r) -> ProgramPipelineHandle::Stages;
+
+/// The separable programs making up a pipeline. Stages without a program are left empty.
+struct PipelineStages
+{
+    ProgramHandle vertex;
+    ProgramHandle tess_control;
+    ProgramHandle tess_evaluation;
+    ProgramHandle geometry;
+    ProgramHandle fragment;
+    ProgramHandle compute;
+};
+
+/// Creates one program pipeline for each distinct combination of separable programs.
+/**
+ * With N vertex and M fragment programs, this costs N + M compiles and at most N × M cheap pipeline objects instead
+ * of N × M program links. The cache doesn't own the programs; clear() it before destroying them.
+ */
+class ProgramPipelineCache
+{
+public:
+    /// Get the pipeline made of @p stages, creating it on first use.
+    auto get(const PipelineStages &stages) -> ProgramPipelineHandle;
+
+    /// Number of pipelines created.
+    [[nodiscard]]
+    auto size() const -> std::size_t
+    { return m_pipelines.size(); }
+
+    /// Destroy all pipelines.
+    void clear()
+    { m_pipelines.clear(); }
+
+private:
+    using Key = std::array<GLuint, 6>;
+
+    struct KeyHash
+    {
+        auto operator()(const Key &key) const -> std::size_t;
+    };
+
+    std::unordered_map<Key, ProgramPipeline, KeyHash> m_pipelines;
+};
+
+} // GL
+
+#endif //GLUTILS_PROGRAM_PIPELINE_HPP
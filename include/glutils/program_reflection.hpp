@@ -0,0 +1,113 @@
+#ifndef GLUTILS_PROGRAM_REFLECTION_HPP
+#define GLUTILS_PROGRAM_REFLECTION_HPP
+
+#include "program.hpp"
+#include "hash.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace GL {
+
+/// A snapshot of the active resources of a linked program, indexed by name hash.
+/**
+ * Built once after ProgramHandle::link(), with one glGetProgramResourceiv call per resource. Lookups hash the name
+ * (see GL::hash()) and probe a flat table, so they never call into the driver. Keys may be computed at compile time:
+ *
+ *      constexpr auto u_color = GL::hash("u_color");
+ *      program.setUniform(reflection.getLocation(u_color), color);
+ *
+ * The "[0]" suffix of array resources is dropped from their key, so "lights" and "lights[0]" find the same resource.
+ * Covers the uniform, uniform_block, shader_storage_block, program_input and buffer_variable interfaces.
+ */
+class ProgramReflection
+{
+public:
+    using Interface = ProgramHandle::Interface;
+
+    /// An active resource. Properties that don't apply to the resource's interface are -1.
+    struct Resource
+    {
+        Interface interface;
+        GLuint index;
+        std::string name;
+        std::uint64_t key;
+
+        /// GLSL type enum, e.g. GL_FLOAT_VEC4. Zero for blocks.
+        GLenum type{0};
+        GLint array_size{-1};
+        GLint location{-1};
+
+        // layout within a block, in bytes
+        GLint offset{-1};
+        GLint array_stride{-1};
+        GLint matrix_stride{-1};
+        GLint block_index{-1};
+        GLint top_level_array_size{-1};
+        GLint top_level_array_stride{-1};
+
+        // blocks only
+        GLint buffer_binding{-1};
+        GLint buffer_data_size{-1};
+        GLint active_variables{-1};
+    };
+
+    ProgramReflection() = default;
+
+    /// Query all the active resources of the linked @p program.
+    explicit ProgramReflection(ProgramHandle program);
+
+    /// Find a resource by its name hash. Returns null if the program has no such active resource.
+    [[nodiscard]]
+    auto find(Interface interface, std::uint64_t key) const -> const Resource *;
+
+    [[nodiscard]]
+    auto find(Interface interface, std::string_view name) const -> const Resource *
+    { return find(interface, hash(name)); }
+
+    /// Location of the uniform with name hash @p key, or -1 if it isn't active.
+    [[nodiscard]]
+    auto getLocation(std::uint64_t key) const -> GLint
+    {
+        const auto resource = find(Interface::uniform, key);
+        return resource ? resource->location : -1;
+    }
+
+    [[nodiscard]]
+    auto getLocation(std::string_view name) const -> GLint
+    { return getLocation(hash(name)); }
+
+    /// Index of the resource with name hash @p key within @p interface, or GL_INVALID_INDEX if it isn't active.
+    [[nodiscard]]
+    auto getIndex(Interface interface, std::uint64_t key) const -> GLuint
+    {
+        const auto resource = find(interface, key);
+        return resource ? resource->index : 0xFFFFFFFFu;
+    }
+
+    /// All resources, grouped by interface in the order listed above and sorted by index within each interface.
+    [[nodiscard]]
+    auto getResources() const -> const std::vector<Resource> &
+    { return m_resources; }
+
+    /// The resources of a single interface, as a pair of pointers into getResources().
+    [[nodiscard]]
+    auto getResources(Interface interface) const -> std::pair<const Resource *, const Resource *>;
+
+private:
+    [[nodiscard]] static auto slotKey(Interface interface, std::uint64_t key) -> std::uint64_t;
+
+    void insert(std::uint32_t resource_index);
+
+    std::vector<Resource> m_resources;
+
+    // open addressing table of indices into m_resources plus one; zero marks an empty slot
+    std::vector<std::uint32_t> m_slots;
+};
+
+} // GL
+
+#endif //GLUTILS_PROGRAM_REFLECTION_HPP
@@ -0,0 +1,132 @@
+#ifndef GLUTILS_SAMPLER_HPP
+#define GLUTILS_SAMPLER_HPP
+
+#include "handle.hpp"
+#include "object.hpp"
+
+#include <array>
+#include <vector>
+
+namespace GL {
+
+class SamplerHandle : public Handle
+{
+    using Handle::Handle;
+public:
+    static auto create() -> SamplerHandle;
+
+    static void destroy(SamplerHandle sampler);
+
+    enum class MinFilter : GLenum
+    {
+        nearest = 0x2600,
+        linear = 0x2601,
+        nearest_mipmap_nearest = 0x2700,
+        linear_mipmap_nearest = 0x2701,
+        nearest_mipmap_linear = 0x2702,
+        linear_mipmap_linear = 0x2703,
+    };
+
+    enum class MagFilter : GLenum
+    {
+        nearest = 0x2600,
+        linear = 0x2601,
+    };
+
+    enum class Wrap : GLenum
+    {
+        repeat = 0x2901,
+        mirrored_repeat = 0x8370,
+        clamp_to_edge = 0x812F,
+        clamp_to_border = 0x812D,
+        mirror_clamp_to_edge = 0x8743,
+    };
+
+    enum class CompareMode : GLenum
+    {
+        none = 0x0000,
+        compare_ref_to_texture = 0x884E,
+    };
+
+    enum class CompareFunc : GLenum
+    {
+        never = 0x0200,
+        less = 0x0201,
+        equal = 0x0202,
+        lequal = 0x0203,
+        greater = 0x0204,
+        notequal = 0x0205,
+        gequal = 0x0206,
+        always = 0x0207,
+    };
+
+    /// glSamplerParameteri with GL_TEXTURE_MIN_FILTER. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glSamplerParameter.xhtml
+    void setMinFilter(MinFilter filter) const;
+
+    /// glSamplerParameteri with GL_TEXTURE_MAG_FILTER.
+    void setMagFilter(MagFilter filter) const;
+
+    /// glSamplerParameteri with GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T and GL_TEXTURE_WRAP_R.
+    void setWrap(Wrap s, Wrap t, Wrap r) const;
+
+    /// Set the same wrap mode for all coordinates.
+    void setWrap(Wrap wrap) const
+    { setWrap(wrap, wrap, wrap); }
+
+    /// glSamplerParameterf with GL_TEXTURE_MAX_ANISOTROPY.
+    /**
+     * @param anisotropy from 1 (no anisotropic filtering) to Limits::max_texture_max_anisotropy.
+     */
+    void setMaxAnisotropy(GLfloat anisotropy) const;
+
+    /// glSamplerParameterf with GL_TEXTURE_LOD_BIAS.
+    void setLodBias(GLfloat bias) const;
+
+    /// glSamplerParameterf with GL_TEXTURE_MIN_LOD and GL_TEXTURE_MAX_LOD.
+    void setLodRange(GLfloat min, GLfloat max) const;
+
+    /// glSamplerParameteri with GL_TEXTURE_COMPARE_MODE.
+    void setCompareMode(CompareMode mode) const;
+
+    /// glSamplerParameteri with GL_TEXTURE_COMPARE_FUNC.
+    void setCompareFunc(CompareFunc func) const;
+
+    /// glSamplerParameterfv with GL_TEXTURE_BORDER_COLOR.
+    void setBorderColor(const std::array<GLfloat, 4> &color) const;
+
+    /// glBindSampler — bind a named sampler to a texturing target. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBindSampler.xhtml
+    /**
+     * A zero handle unbinds the sampler, so the texture's own parameters are used again.
+     */
+    static void bind(GLuint unit, SamplerHandle sampler);
+
+    /// glBindSamplers — bind one or more named sampler objects to a sequence of consecutive sampler units. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBindSamplers.xhtml
+    /**
+     * @param begin Begin iterator over SamplerHandle.
+     * @param end End iterator.
+     */
+    template<typename InputIter>
+    static void bindSamplers(GLuint first_unit, InputIter begin, InputIter end)
+    {
+        std::vector<GLuint> samplers;
+        GLsizei count = 0;
+
+        auto iter = begin;
+        while (iter != end)
+        {
+            samplers.emplace_back(iter++->getName());
+            count++;
+        }
+
+        s_bindSamplers(first_unit, count, samplers.data());
+    }
+
+private:
+    static void s_bindSamplers(GLuint first_unit, GLsizei count, const GLuint *samplers);
+};
+
+using Sampler = Object<SamplerHandle>;
+
+} // GL
+
+#endif //GLUTILS_SAMPLER_HPP
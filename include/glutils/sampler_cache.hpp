@@ -0,0 +1,82 @@
+#ifndef GLUTILS_SAMPLER_CACHE_HPP
+#define GLUTILS_SAMPLER_CACHE_HPP
+
+#include "sampler.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace GL {
+
+/// The state of a sampler object. The defaults are those of a new sampler.
+struct SamplerDescription
+{
+    SamplerHandle::MinFilter min_filter{SamplerHandle::MinFilter::nearest_mipmap_linear};
+    SamplerHandle::MagFilter mag_filter{SamplerHandle::MagFilter::linear};
+    SamplerHandle::Wrap wrap_s{SamplerHandle::Wrap::repeat};
+    SamplerHandle::Wrap wrap_t{SamplerHandle::Wrap::repeat};
+    SamplerHandle::Wrap wrap_r{SamplerHandle::Wrap::repeat};
+    GLfloat max_anisotropy{1.0f};
+    GLfloat lod_bias{0.0f};
+    GLfloat min_lod{-1000.0f};
+    GLfloat max_lod{1000.0f};
+    SamplerHandle::CompareMode compare_mode{SamplerHandle::CompareMode::none};
+    SamplerHandle::CompareFunc compare_func{SamplerHandle::CompareFunc::lequal};
+    std::array<GLfloat, 4> border_color{};
+
+    /// FNV-1a hash of all fields. -0 hashes like 0, as they compare equal.
+    [[nodiscard]]
+    auto getHash() const -> std::uint64_t;
+};
+
+bool operator==(const SamplerDescription &lhs, const SamplerDescription &rhs);
+
+bool operator!=(const SamplerDescription &lhs, const SamplerDescription &rhs);
+
+/// Shares one sampler object between all users of the same sampler state.
+/**
+ * Materials describe their sampling state with a SamplerDescription and get a sampler from the cache, instead of
+ * setting texture parameters whenever they are drawn. Samplers are created on first use and live as long as the cache.
+ */
+class SamplerCache
+{
+public:
+    /// The sampler with the state @p description, created if it doesn't exist yet.
+    /**
+     * The anisotropy is clamped to Limits::max_texture_max_anisotropy before lookup, so descriptions which only differ
+     * above the limit share a sampler.
+     * @throw GL::Error if a value of @p description is NaN.
+     */
+    [[nodiscard]]
+    auto get(SamplerDescription description) -> SamplerHandle;
+
+    /// Number of distinct samplers created.
+    [[nodiscard]]
+    auto getSamplerCount() const -> std::size_t
+    { return m_samplers.size(); }
+
+    /// Number of get() calls which returned an existing sampler.
+    [[nodiscard]]
+    auto getHitCount() const -> std::size_t
+    { return m_hit_count; }
+
+    /// Delete all samplers. Handles returned before become invalid.
+    void clear()
+    { m_samplers.clear(); }
+
+private:
+    struct Hasher
+    {
+        auto operator()(const SamplerDescription &description) const -> std::size_t
+        { return static_cast<std::size_t>(description.getHash()); }
+    };
+
+    std::unordered_map<SamplerDescription, Sampler, Hasher> m_samplers;
+    std::size_t m_hit_count{0};
+};
+
+} // GL
+
+#endif //GLUTILS_SAMPLER_CACHE_HPP
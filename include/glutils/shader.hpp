@@ -4,10 +4,17 @@
 #include "handle.hpp"
 #include "object.hpp"
 
+#include <cstddef>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace GL {
 
+class SpecializationConstants;
+
 class ShaderHandle : public Handle
 {
     using Handle::Handle;
@@ -63,13 +70,36 @@ public:
     /// Compiles the shader object.
     void compile() const;
 
+    /// glShaderBinary — load a precompiled shader binary into the shader object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glShaderBinary.xhtml
+    void setBinary(GLenum binary_format, const void *binary, GLsizei length) const;
+
+    /// Load a SPIR-V module, i.e. setBinary() with GL_SHADER_BINARY_FORMAT_SPIR_V. Follow with specialize().
+    void setSpirV(const void *binary, GLsizei length) const;
+
+    /// glSpecializeShader — specialize a SPIR-V shader and select its entry point. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glSpecializeShader.xhtml
+    /**
+     * Takes the place of compile() for SPIR-V shaders; check Parameter::compile_status afterwards.
+     * @param entry_point name of the entry point function, usually "main".
+     * @param count number of specialization constants.
+     * @param constant_indices ids of the specialization constants to set.
+     * @param constant_values values of the specialization constants, as their 32-bit representation.
+     */
+    void specialize(const GLchar *entry_point, GLuint count, const GLuint *constant_indices,
+                    const GLuint *constant_values) const;
+
+    /// specialize overload taking a set of specialization constants.
+    void specialize(const GLchar *entry_point, const SpecializationConstants &constants) const;
+
     enum class Parameter
     {
         type = 0x8B4F,
         delete_status = 0x8B80,
         compile_status = 0x8B81,
         info_log_length = 0x8B84,
-        source_length = 0x8B88
+        source_length = 0x8B88,
+        spir_v_binary = 0x9552,
+        /// requires GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile
+        completion_status = 0x91B1
     };
 
     [[nodiscard]]
@@ -83,6 +113,69 @@ public:
 
 using Shader = Object<ShaderHandle>;
 
+/// Values for the specialization constants of a SPIR-V shader, keyed by their constant_id.
+/**
+ * Usage:
+ *
+ *      SpecializationConstants constants;
+ *      constants.set(0, true).set(1, 16u).set(2, 0.5f);
+ *      shader.setSpirV(module.data(), module.size());
+ *      shader.specialize("main", constants);
+ */
+class SpecializationConstants
+{
+public:
+    /// Set the constant with constant_id @p id. T may be bool, or any 32-bit integer or floating point type.
+    template<typename T>
+    auto set(GLuint id, T value) -> SpecializationConstants &
+    {
+        static_assert(std::is_same_v<T, bool> || (std::is_arithmetic_v<T> && sizeof(T) == sizeof(GLuint)),
+                      "specialization constants must be bool or 32-bit scalars");
+
+        GLuint bits;
+        if constexpr (std::is_same_v<T, bool>)
+            bits = value ? 1 : 0;
+        else
+            std::memcpy(&bits, &value, sizeof(bits));
+
+        for (std::size_t i = 0; i < m_ids.size(); i++)
+        {
+            if (m_ids[i] == id)
+            {
+                m_values[i] = bits;
+                return *this;
+            }
+        }
+
+        m_ids.push_back(id);
+        m_values.push_back(bits);
+        return *this;
+    }
+
+    [[nodiscard]]
+    auto getCount() const -> GLuint
+    { return static_cast<GLuint>(m_ids.size()); }
+
+    [[nodiscard]]
+    auto getIds() const -> const GLuint *
+    { return m_ids.data(); }
+
+    [[nodiscard]]
+    auto getValues() const -> const GLuint *
+    { return m_values.data(); }
+
+private:
+    std::vector<GLuint> m_ids;
+    std::vector<GLuint> m_values;
+};
+
+/// The source code of one shader stage.
+struct ShaderSource
+{
+    ShaderHandle::Type type;
+    std::string_view source;
+};
+
 } // GL
 
 #endif //SIMPLERENDERER_SHADER_HPP
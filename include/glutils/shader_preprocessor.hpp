@@ -0,0 +1,134 @@
+#ifndef GLUTILS_SHADER_PREPROCESSOR_HPP
+#define GLUTILS_SHADER_PREPROCESSOR_HPP
+
+#include "shader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace GL {
+
+/// A set of preprocessor definitions, as (name, value) pairs. The value may be empty.
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+/// Resolves #include directives and injects #define lines into GLSL source code.
+/**
+ * "#include "file"" and "#include <file>" are looked up relative to the including file, then in each include
+ * directory in order. Every file is included at most once per expansion, like with #pragma once, which also breaks
+ * include cycles. #line directives are inserted around included code so compiler messages point at the right line;
+ * source string number 0 is the top-level source and n is the n-th entry of Expansion::dependencies.
+ *
+ * Defines are sorted by name and inserted after the #version directive, so define sets that only differ in order
+ * expand to the same code.
+ *
+ * File contents are cached; call invalidate() when files change. The preprocessor also keeps the include graph of the
+ * files it expanded, so getDependents() can tell which shaders a changed file affects.
+ */
+class ShaderPreprocessor
+{
+public:
+    struct Expansion
+    {
+        std::string source;
+        /// GL::hash() of source.
+        std::uint64_t hash;
+        /// Paths of all the files the expansion includes, directly or indirectly.
+        std::vector<std::string> dependencies;
+        /// Include edges as (including, included) source numbers, one per #include directive, including those of
+        /// files that were already included.
+        std::vector<std::pair<std::size_t, std::size_t>> includes;
+    };
+
+    explicit ShaderPreprocessor(std::vector<std::string> include_directories = {});
+
+    /// Expand @p source, resolving relative includes from @p directory.
+    /**
+     * @throw GL::Error if an included file can't be found.
+     */
+    [[nodiscard]]
+    auto expand(std::string_view source, const ShaderDefines &defines = {}, const std::string &directory = ".")
+    -> Expansion;
+
+    /// Expand the file at @p path. The file itself is not listed in the dependencies.
+    [[nodiscard]]
+    auto expandFile(const std::string &path, const ShaderDefines &defines = {}) -> Expansion;
+
+    /// Drop the cached contents of @p path, or of all files if @p path is empty.
+    /**
+     * The files that include @p path keep their cached contents; only their expansions change.
+     */
+    void invalidate(const std::string &path = {});
+
+    /// Files that include @p path directly or indirectly, as of their last expansion, sorted.
+    /**
+     * Files given to expandFile() are part of the graph, so these are the shaders to expand again when @p path
+     * changes. Source passed to expand() isn't a file and is never listed.
+     */
+    [[nodiscard]]
+    auto getDependents(const std::string &path) const -> std::vector<std::string>;
+
+private:
+    auto load(const std::string &path) -> const std::string &;
+
+    auto resolve(std::string_view name, const std::string &directory) -> std::string;
+
+    void append(std::string_view source, std::size_t source_number, std::size_t first_line,
+                const std::string &directory, Expansion &expansion);
+
+    std::vector<std::string> m_include_directories;
+    std::unordered_map<std::string, std::string> m_files;
+    // files each file includes directly
+    std::unordered_map<std::string, std::vector<std::string>> m_includes;
+};
+
+/// Compiles each distinct shader variant once.
+/**
+ * Variants are identified by their shader type and the hash of their expanded source, so permutations whose defines
+ * don't change the expanded code (or which only differ in define order) share a shader object.
+ */
+class ShaderVariantCache
+{
+public:
+    explicit ShaderVariantCache(ShaderPreprocessor &preprocessor) : m_preprocessor(preprocessor)
+    {}
+
+    /// Get the compiled shader for @p path expanded with @p defines, compiling it if this variant wasn't seen before.
+    /**
+     * Check the compile status of the returned shader; failed variants are cached as well.
+     */
+    auto get(ShaderHandle::Type type, const std::string &path, const ShaderDefines &defines) -> ShaderHandle;
+
+    /// Same as get(), for source code that doesn't come from a file.
+    auto getFromSource(ShaderHandle::Type type, std::string_view source, const ShaderDefines &defines)
+    -> ShaderHandle;
+
+    /// Number of requests made through get() and getFromSource().
+    [[nodiscard]]
+    auto getRequestCount() const -> std::size_t
+    { return m_request_count; }
+
+    /// Number of distinct variants, i.e. of shaders compiled.
+    [[nodiscard]]
+    auto getVariantCount() const -> std::size_t
+    { return m_shaders.size(); }
+
+    /// Destroy all cached shaders.
+    void clear()
+    { m_shaders.clear(); }
+
+private:
+    auto get(ShaderHandle::Type type, const ShaderPreprocessor::Expansion &expansion) -> ShaderHandle;
+
+    ShaderPreprocessor &m_preprocessor;
+    std::unordered_map<std::uint64_t, Shader> m_shaders;
+    std::size_t m_request_count{0};
+};
+
+} // GL
+
+#endif //GLUTILS_SHADER_PREPROCESSOR_HPP
@@ -0,0 +1,99 @@
+#ifndef GLUTILS_SHADER_RELOADER_HPP
+#define GLUTILS_SHADER_RELOADER_HPP
+
+#include "program.hpp"
+#include "program_compiler.hpp"
+#include "shader.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace GL {
+
+/// Rebuilds programs in the background when their shader files change on disk.
+/**
+ * Files are watched with inotify, so that changes are picked up without polling the file system. Rebuilds go through
+ * a ProgramCompiler, so they use the driver's parallel compilation or worker contexts when available. A program is
+ * only replaced once its rebuild links successfully; until then, and if it fails, the previous one stays in use and
+ * the info log is available through getError().
+ *
+ * Only available on Linux.
+ */
+class ShaderReloader
+{
+public:
+    struct ShaderFile
+    {
+        ShaderHandle::Type type;
+        std::string path;
+    };
+
+    /// @param worker_contexts passed on to the ProgramCompiler used for rebuilds.
+    explicit ShaderReloader(std::vector<ProgramCompiler::MakeContextCurrent> worker_contexts = {});
+
+    ~ShaderReloader();
+
+    ShaderReloader(const ShaderReloader &) = delete;
+
+    ShaderReloader &operator=(const ShaderReloader &) = delete;
+
+    /// Build a program from @p files and watch them for changes. Blocks until its first build is done.
+    /**
+     * @return an id for the program, to be passed to the other member functions.
+     * @throw GL::Error if a directory can't be watched.
+     */
+    auto add(std::vector<ShaderFile> files) -> std::size_t;
+
+    /// Process file changes, submit rebuilds and swap in programs whose rebuild finished. Never blocks.
+    /**
+     * Call once per frame, at a point where no draw calls refer to the programs anymore; replaced programs are
+     * destroyed here.
+     * @return the ids of the programs that were replaced.
+     */
+    auto update() -> std::vector<std::size_t>;
+
+    /// The current program for @p id. May change after update(); don't hold on to it across frames.
+    [[nodiscard]]
+    auto getProgram(std::size_t id) const -> ProgramHandle
+    { return m_entries[id].current; }
+
+    /// Number of times the program for @p id was replaced, including the first build.
+    [[nodiscard]]
+    auto getGeneration(std::size_t id) const -> std::size_t
+    { return m_entries[id].generation; }
+
+    /// Error of the last failed build of @p id, or an empty string if the last build succeeded.
+    [[nodiscard]]
+    auto getError(std::size_t id) const -> const std::string &
+    { return m_entries[id].error; }
+
+private:
+    struct Entry
+    {
+        std::vector<ShaderFile> files;
+        Program current{ProgramHandle()};
+        Program pending{ProgramHandle()};
+        std::size_t generation{0};
+        std::string error;
+        bool changed{false};
+    };
+
+    void submit(std::size_t id);
+
+    void complete(const std::vector<ProgramCompiler::Result> &results, std::vector<std::size_t> &replaced);
+
+    void readEvents();
+
+    ProgramCompiler m_compiler;
+    std::vector<Entry> m_entries;
+
+    int m_inotify_fd{-1};
+    std::unordered_map<int, std::string> m_watched_directories;     // watch descriptor -> directory
+    std::unordered_map<std::string, std::vector<std::size_t>> m_file_entries; // file path -> entry ids
+};
+
+} // GL
+
+#endif //GLUTILS_SHADER_RELOADER_HPP
@@ -0,0 +1,266 @@
+#ifndef GLUTILS_SPARSE_HPP
+#define GLUTILS_SPARSE_HPP
+
+#include "buffer.hpp"
+#include "texture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+namespace GL {
+
+/// Tracks which pages of a sparse resource are committed, and keeps their number under a budget. Doesn't use OpenGL.
+/**
+ * Pages are identified by 64-bit keys chosen by the owner. request() commits a page through the commit function
+ * given to the constructor; when the budget is reached, the least recently requested pages which weren't requested
+ * since the last call to nextFrame() are decommitted first.
+ */
+class SparsePageTable
+{
+public:
+    /// Commits (@p commit true) or decommits the memory of @p page.
+    using CommitFunction = std::function<void(std::uint64_t page, bool commit)>;
+
+    /// @param budget maximum number of committed pages.
+    SparsePageTable(std::size_t budget, CommitFunction commit);
+
+    /// Commit @p page if it isn't yet, and mark it used in the current frame.
+    /**
+     * @return false if the page isn't committed, because the budget is reached and all committed pages were used in
+     * the current frame.
+     */
+    bool request(std::uint64_t page);
+
+    /// Decommit @p page if it is committed.
+    void release(std::uint64_t page);
+
+    /// Decommit all pages.
+    void releaseAll();
+
+    /// Start a new frame: pages used before may be decommitted again.
+    void nextFrame()
+    { m_frame++; }
+
+    [[nodiscard]]
+    bool isCommitted(std::uint64_t page) const
+    { return m_pages.count(page) != 0; }
+
+    [[nodiscard]]
+    auto getCommittedCount() const -> std::size_t
+    { return m_pages.size(); }
+
+    [[nodiscard]]
+    auto getBudget() const -> std::size_t
+    { return m_budget; }
+
+    /// Number of pages committed since construction.
+    [[nodiscard]]
+    auto getCommitCount() const -> std::size_t
+    { return m_commit_count; }
+
+    /// Number of pages decommitted to stay under the budget since construction.
+    [[nodiscard]]
+    auto getEvictionCount() const -> std::size_t
+    { return m_eviction_count; }
+
+private:
+    struct Page
+    {
+        std::list<std::uint64_t>::iterator lru;
+        std::uint64_t last_frame{0};
+    };
+
+    void decommit(std::unordered_map<std::uint64_t, Page>::iterator page);
+
+    std::size_t m_budget;
+    CommitFunction m_commit;
+
+    std::unordered_map<std::uint64_t, Page> m_pages;
+    // committed pages, most recently requested first
+    std::list<std::uint64_t> m_lru;
+    std::uint64_t m_frame{1};
+
+    std::size_t m_commit_count{0};
+    std::size_t m_eviction_count{0};
+};
+
+/// A texture whose storage is committed page by page (GL_ARB_sparse_texture).
+/**
+ * Levels smaller than a page form the mip tail, which is committed as a whole at construction and isn't counted
+ * against the budget.
+ *
+ * In simulation mode, the texture is created without storage and no commitment is made, but the page table behaves
+ * as with real sparse storage, so residency policies can be exercised without driver support.
+ */
+class SparseTexture
+{
+public:
+    /// Size of a page in texels.
+    struct PageSize
+    {
+        GLint x{0};
+        GLint y{0};
+        /// 1 for 2D pages
+        GLint z{1};
+    };
+
+    /// The page size of the first virtual page size index of @p internal_format, or std::nullopt if sparse textures
+    /// of that type and format aren't supported.
+    [[nodiscard]]
+    static auto queryPageSize(TextureHandle::Type type, TextureHandle::SizedInternalFormat internal_format)
+    -> std::optional<PageSize>;
+
+    /// Create a sparse texture of type _2d, _2d_array or _3d.
+    /**
+     * @param depth depth of a _3d texture, or number of layers of a _2d_array one; 1 for _2d.
+     * @param page_budget maximum number of committed pages, not counting the mip tail.
+     * @param simulated_page_size if set, simulate sparse storage with these pages.
+     * @throw GL::Error if sparse textures aren't supported and no simulated page size is given, or if a component of
+     * the simulated page size isn't positive.
+     */
+    SparseTexture(TextureHandle::Type type, TextureHandle::SizedInternalFormat internal_format, GLsizei levels,
+                  GLsizei width, GLsizei height, GLsizei depth, std::size_t page_budget,
+                  std::optional<PageSize> simulated_page_size = std::nullopt);
+
+    ~SparseTexture();
+
+    SparseTexture(const SparseTexture &) = delete;
+
+    SparseTexture &operator=(const SparseTexture &) = delete;
+
+    /// Commit the pages of @p level covering the given region.
+    /**
+     * The region is clipped to the level; nothing is committed if it is empty.
+     * @return false if some pages couldn't be committed within the budget.
+     */
+    bool request(GLint level, GLint x, GLint y, GLint z, GLsizei width = 1, GLsizei height = 1, GLsizei depth = 1);
+
+    /// @copydoc SparsePageTable::nextFrame
+    void nextFrame()
+    { m_pages.nextFrame(); }
+
+    [[nodiscard]]
+    auto getTexture() const -> TextureHandle
+    { return m_texture; }
+
+    [[nodiscard]]
+    auto getPageSize() const -> PageSize
+    { return m_page_size; }
+
+    /// Number of levels committed page by page; the levels after them form the mip tail.
+    [[nodiscard]]
+    auto getSparseLevels() const -> GLsizei
+    { return m_sparse_levels; }
+
+    [[nodiscard]]
+    auto getPageTable() const -> const SparsePageTable &
+    { return m_pages; }
+
+    [[nodiscard]]
+    bool isSimulated() const
+    { return m_simulated; }
+
+private:
+    void commit(GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth, bool commit);
+
+    void commitPage(std::uint64_t page, bool commit);
+
+    [[nodiscard]]
+    auto getLevelSize(GLint level) const -> PageSize;
+
+    Texture m_texture;
+    TextureHandle::Type m_type;
+    GLsizei m_levels;
+    GLsizei m_width;
+    GLsizei m_height;
+    GLsizei m_depth;
+    PageSize m_page_size;
+    GLsizei m_sparse_levels{0};
+    bool m_simulated;
+    SparsePageTable m_pages;
+
+    // GL_ARB_sparse_texture entry points
+    struct Procs;
+    std::unique_ptr<Procs> m_procs;
+};
+
+/// A buffer whose storage is committed page by page (GL_ARB_sparse_buffer).
+/**
+ * In simulation mode, the buffer has no storage and no commitment is made, but the page table behaves as with real
+ * sparse storage.
+ */
+class SparseBuffer
+{
+public:
+    /// GL_SPARSE_BUFFER_PAGE_SIZE_ARB, or std::nullopt if sparse buffers aren't supported.
+    [[nodiscard]]
+    static auto queryPageSize() -> std::optional<GLsizeiptr>;
+
+    /// Create a sparse buffer of @p size bytes of virtual memory.
+    /**
+     * @param page_budget maximum number of committed pages.
+     * @param simulated_page_size if set, simulate sparse storage with pages of that many bytes.
+     * @throw GL::Error if sparse buffers aren't supported and no simulated page size is given, or if the simulated page
+     * size isn't positive.
+     */
+    SparseBuffer(GLsizeiptr size, std::size_t page_budget, std::optional<GLsizeiptr> simulated_page_size = std::nullopt);
+
+    ~SparseBuffer();
+
+    SparseBuffer(const SparseBuffer &) = delete;
+
+    SparseBuffer &operator=(const SparseBuffer &) = delete;
+
+    /// Commit the pages covering @p size bytes at @p offset.
+    /**
+     * The range is clipped to the buffer; nothing is committed if it is empty.
+     * @return false if some pages couldn't be committed within the budget.
+     */
+    bool request(GLintptr offset, GLsizeiptr size);
+
+    /// @copydoc SparsePageTable::nextFrame
+    void nextFrame()
+    { m_pages.nextFrame(); }
+
+    [[nodiscard]]
+    auto getBuffer() const -> BufferHandle
+    { return m_buffer; }
+
+    [[nodiscard]]
+    auto getSize() const -> GLsizeiptr
+    { return m_size; }
+
+    [[nodiscard]]
+    auto getPageSize() const -> GLsizeiptr
+    { return m_page_size; }
+
+    [[nodiscard]]
+    auto getPageTable() const -> const SparsePageTable &
+    { return m_pages; }
+
+    [[nodiscard]]
+    bool isSimulated() const
+    { return m_simulated; }
+
+private:
+    void commitPage(std::uint64_t page, bool commit);
+
+    Buffer m_buffer;
+    GLsizeiptr m_size;
+    GLsizeiptr m_page_size;
+    bool m_simulated;
+    SparsePageTable m_pages;
+
+    // GL_ARB_sparse_buffer entry points
+    struct Procs;
+    std::unique_ptr<Procs> m_procs;
+};
+
+} // GL
+
+#endif //GLUTILS_SPARSE_HPP
@@ -0,0 +1,86 @@
+#ifndef GLUTILS_STREAMED_TEXTURE_HPP
+#define GLUTILS_STREAMED_TEXTURE_HPP
+
+#include "mapped_file.hpp"
+#include "texture.hpp"
+#include "texture_container.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace GL {
+
+/// A texture loaded from a memory-mapped KTX2 or DDS file, from its smallest level up, a few bytes per frame.
+/**
+ * The storage of all levels is allocated up front, then stream() uploads the images straight from the mapping,
+ * smallest level first. GL_TEXTURE_BASE_LEVEL follows the finest complete level, so the texture can be sampled as
+ * soon as its smallest level is uploaded and sharpens as larger levels arrive. Levels are uploaded in strips of rows
+ * so that large ones can be spread over several frames.
+ *
+ * Only available on POSIX systems.
+ */
+class StreamedTexture
+{
+public:
+    /// Map and parse the file at @p path, and allocate the storage of the texture. Nothing is uploaded yet.
+    /**
+     * @throw GL::Error if the file can't be mapped or parsed, see TextureContainer.
+     */
+    explicit StreamedTexture(const std::string &path);
+
+    /// Upload the next images, or strips of them, until @p budget bytes are uploaded.
+    /**
+     * At least one row of pixels, or of blocks, is uploaded per call, even if it is larger than @p budget.
+     * Unpack state other than GL_UNPACK_ALIGNMENT is expected to be the default, and no buffer may be bound to
+     * GL_PIXEL_UNPACK_BUFFER.
+     * @return true if the whole texture is uploaded.
+     */
+    bool stream(std::size_t budget);
+
+    [[nodiscard]]
+    bool isComplete() const
+    { return m_next_image == m_container.getImages().size(); }
+
+    [[nodiscard]]
+    auto getTexture() const -> TextureHandle
+    { return m_texture; }
+
+    [[nodiscard]]
+    auto getContainer() const -> const TextureContainer &
+    { return m_container; }
+
+    /// The finest level uploaded completely, or the number of levels if none is yet.
+    [[nodiscard]]
+    auto getBaseLevel() const -> GLint
+    { return m_base_level; }
+
+    /// Bytes uploaded so far.
+    [[nodiscard]]
+    auto getUploadedSize() const -> std::size_t
+    { return m_uploaded_size; }
+
+    /// Bytes of all images.
+    [[nodiscard]]
+    auto getTotalSize() const -> std::size_t
+    { return m_total_size; }
+
+private:
+    void upload(const TextureContainer::Image &image, GLint y, GLsizei height, const unsigned char *data,
+                std::size_t size) const;
+
+    MappedFile m_file;
+    TextureContainer m_container;
+    Texture m_texture;
+
+    std::size_t m_next_image{0};
+    // first row of the next strip of the next image, in rows of blocks for compressed formats
+    GLsizei m_next_row{0};
+    GLint m_base_level;
+
+    std::size_t m_uploaded_size{0};
+    std::size_t m_total_size{0};
+};
+
+} // GL
+
+#endif //GLUTILS_STREAMED_TEXTURE_HPP
@@ -4,6 +4,8 @@
 #include "handle.hpp"
 #include "object.hpp"
 
+#include <cstddef>
+
 namespace GL {
 
 class TextureHandle : public Handle
@@ -19,6 +21,7 @@ public:
         _2d_array = 0x8C1A,
         rectangle = 0x84F5,
         cube_map = 0x8513,
+        cube_map_array = 0x9009,
         buffer = 0x8C2A,
         _2d_multisample = 0x9100,
         _2d_multisample_array = 0x9102
@@ -91,11 +94,67 @@ public:
         rgba16ui = 0x8D76,
         rgba32i = 0x8D76,
         rgba32ui = 0x8D70,
+        compressed_red_rgtc1 = 0x8DBB,
+        compressed_signed_red_rgtc1 = 0x8DBC,
+        compressed_rg_rgtc2 = 0x8DBD,
+        compressed_signed_rg_rgtc2 = 0x8DBE,
+        compressed_rgba_bptc_unorm = 0x8E8C,
+        compressed_srgb_alpha_bptc_unorm = 0x8E8D,
+        compressed_rgb_bptc_signed_float = 0x8E8E,
+        compressed_rgb_bptc_unsigned_float = 0x8E8F,
+        compressed_rgb8_etc2 = 0x9274,
+        compressed_srgb8_etc2 = 0x9275,
+        compressed_rgb8_punchthrough_alpha1_etc2 = 0x9276,
+        compressed_srgb8_punchthrough_alpha1_etc2 = 0x9277,
+        compressed_rgba8_etc2_eac = 0x9278,
+        compressed_srgb8_alpha8_etc2_eac = 0x9279,
+        compressed_r11_eac = 0x9270,
+        compressed_signed_r11_eac = 0x9271,
+        compressed_rg11_eac = 0x9272,
+        compressed_signed_rg11_eac = 0x9273,
+        /// GL_EXT_texture_compression_s3tc
+        compressed_rgb_s3tc_dxt1 = 0x83F0,
+        compressed_rgba_s3tc_dxt1 = 0x83F1,
+        compressed_rgba_s3tc_dxt3 = 0x83F2,
+        compressed_rgba_s3tc_dxt5 = 0x83F3,
+        /// GL_EXT_texture_sRGB with GL_EXT_texture_compression_s3tc
+        compressed_srgb_s3tc_dxt1 = 0x8C4C,
+        compressed_srgb_alpha_s3tc_dxt1 = 0x8C4D,
+        compressed_srgb_alpha_s3tc_dxt3 = 0x8C4E,
+        compressed_srgb_alpha_s3tc_dxt5 = 0x8C4F,
     };
 
+    /// Size in bytes of a 4x4 block of @p internal_format, or 0 if it isn't a block-compressed format.
+    [[nodiscard]]
+    static auto getBlockSize(SizedInternalFormat internal_format) -> GLsizei;
+
+    /// Size in bytes of a @p width x @p height image of the block-compressed @p internal_format.
+    [[nodiscard]]
+    static auto getCompressedImageSize(SizedInternalFormat internal_format, GLsizei width, GLsizei height) -> GLsizei
+    { return (width + 3) / 4 * ((height + 3) / 4) * getBlockSize(internal_format); }
+
+    /// glTextureStorage1D — simultaneously specify storage for all levels of a one-dimensional texture
+    void setStorage1D(GLsizei levels, SizedInternalFormat internal_format, GLsizei width) const;
+
     /// glTextureStorage2D — simultaneously specify storage for all levels of a two-dimensional or one-dimensional array texture
     void setStorage2D(GLsizei levels, SizedInternalFormat internal_format, GLsizei width, GLsizei height) const;
 
+    /// glTextureStorage3D — simultaneously specify storage for all levels of a three-dimensional, two-dimensional array or cube-map array texture
+    /**
+     * @param depth depth of a 3D texture, number of layers of a 2D array, or 6 times the number of cube maps of a
+     * cube map array.
+     */
+    void setStorage3D(GLsizei levels, SizedInternalFormat internal_format, GLsizei width, GLsizei height,
+                      GLsizei depth) const;
+
+    /// glTextureStorage2DMultisample — specify storage for a two-dimensional multisample texture
+    void setStorage2DMultisample(GLsizei samples, SizedInternalFormat internal_format, GLsizei width, GLsizei height,
+                                 bool fixed_sample_locations = true) const;
+
+    /// glTextureStorage3DMultisample — specify storage for a two-dimensional multisample array texture
+    void setStorage3DMultisample(GLsizei samples, SizedInternalFormat internal_format, GLsizei width, GLsizei height,
+                                 GLsizei depth, bool fixed_sample_locations = true) const;
+
     enum class BaseInternalFormat : GLenum
     {
         red = 0x1903,
@@ -140,13 +199,102 @@ public:
         uint_2_10_10_10_rev = 0x8368
     };
 
+    /// Size in bytes of one pixel of client data in @p format and @p type.
+    [[nodiscard]]
+    static auto getPixelSize(DataFormat format, DataType type) -> GLsizei;
+
+    /// glTextureSubImage1D — specify a one-dimensional texture subimage.
+    void updateImage1D(GLint level, GLint xoffset, GLsizei width, DataFormat format, DataType type,
+                       const void *pixel_data) const;
+
     /// glTextureSubImage2D — specify a two-dimensional texture subimage.
     void updateImage2D(GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, DataFormat format,
                        DataType type, const void *pixel_data) const;
 
+    /// glCompressedTextureSubImage2D — specify a two-dimensional texture subimage in a compressed format.
+    /**
+     * https://registry.khronos.org/OpenGL-Refpages/gl4/html/glCompressedTexSubImage2D.xhtml
+     *
+     * With block-compressed formats, @p xoffset and @p yoffset must be multiples of 4, as must @p width and
+     * @p height unless the region extends to the edge of the level.
+     * @param format the internal format of the texture.
+     * @param image_size size of @p data in bytes, see getCompressedImageSize().
+     */
+    void updateCompressedImage2D(GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+                                 SizedInternalFormat format, GLsizei image_size, const void *data) const;
+
+    /// glTextureSubImage3D — specify a three-dimensional texture subimage.
+    /**
+     * Also updates layers of array textures and faces of cube maps, which are addressed by @p zoffset.
+     */
+    void updateImage3D(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height,
+                       GLsizei depth, DataFormat format, DataType type, const void *pixel_data) const;
+
+    /// glCompressedTextureSubImage3D — specify a three-dimensional texture subimage in a compressed format.
+    void updateCompressedImage3D(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                                 GLsizei height, GLsizei depth, SizedInternalFormat format, GLsizei image_size,
+                                 const void *data) const;
+
+    /// glGetTextureSubImage — retrieve a sub-region of a texture image.
+    /**
+     * https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetTextureSubImage.xhtml
+     *
+     * If a buffer is bound to GL_PIXEL_PACK_BUFFER, @p pixels is an offset into it and the call doesn't wait for the
+     * texture to be rendered. Otherwise it blocks until the pixels are written to client memory.
+     * @param buffer_size size of the memory at @p pixels; GL_INVALID_OPERATION is raised if the region exceeds it.
+     */
+    void getSubImage(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height,
+                     GLsizei depth, DataFormat format, DataType type, GLsizei buffer_size, void *pixels) const;
+
+    /// A whole level in a block of staging memory, for updateLevels().
+    struct Level
+    {
+        GLint level{0};
+        GLsizei width{1};
+        /// height, or number of layers of a 1D array
+        GLsizei height{1};
+        /// depth, number of layers of a 2D array, or number of faces of a cube map (array)
+        GLsizei depth{1};
+        /// offset of the level in the staging memory
+        std::size_t offset{0};
+        /// size of the level in bytes; only used by updateCompressedLevels()
+        GLsizei size{0};
+    };
+
+    /// Upload whole levels, including all their layers or faces, from one block of staging memory.
+    /**
+     * One glTextureSubImage call is made per level, of the dimension matching @p type. If a buffer is bound to
+     * GL_PIXEL_UNPACK_BUFFER, @p data is an offset into it, usually nullptr.
+     * @param begin, end iterators over Level.
+     */
+    template<typename InputIter>
+    void updateLevels(Type type, DataFormat format, DataType data_type, const void *data, InputIter begin,
+                      InputIter end) const
+    {
+        for (auto iter = begin; iter != end; ++iter)
+            updateLevel(type, *iter, format, data_type, data);
+    }
+
+    /// Upload whole levels in a block-compressed @p format from one block of staging memory.
+    /**
+     * @copydetails updateLevels
+     */
+    template<typename InputIter>
+    void updateCompressedLevels(Type type, SizedInternalFormat format, const void *data, InputIter begin,
+                                InputIter end) const
+    {
+        for (auto iter = begin; iter != end; ++iter)
+            updateCompressedLevel(type, *iter, format, data);
+    }
+
     void generateMipmap() const;
 
     static void bindTextureUnit(GLuint texture_unit_index, TextureHandle texture);
+
+private:
+    void updateLevel(Type type, const Level &level, DataFormat format, DataType data_type, const void *data) const;
+
+    void updateCompressedLevel(Type type, const Level &level, SizedInternalFormat format, const void *data) const;
 };
 
 using Texture = Object<TextureHandle>;
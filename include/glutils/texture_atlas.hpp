@@ -0,0 +1,155 @@
+#ifndef GLUTILS_TEXTURE_ATLAS_HPP
+#define GLUTILS_TEXTURE_ATLAS_HPP
+
+#include "texture.hpp"
+
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace GL {
+
+/// Packs rectangles into the layers of a texture array. Doesn't use OpenGL.
+/**
+ * A guillotine packer: free space is a list of rectangles. Each rectangle is placed in the free rectangle it fits
+ * best (smallest remaining area, lowest layer first), and the rest of that free rectangle is split in two along the
+ * shorter remaining side. Removed rectangles return to the free list and are merged with free neighbours sharing a
+ * whole edge, so the space can be reused by later insertions. When the last rectangle of a layer is removed, the
+ * whole layer becomes one free rectangle again.
+ */
+class AtlasPacker
+{
+public:
+    /// A rectangle of texels in one layer.
+    struct Rect
+    {
+        GLint layer{0};
+        GLint x{0};
+        GLint y{0};
+        GLsizei width{0};
+        GLsizei height{0};
+    };
+
+    /// @param width width of the layers.
+    /// @param height height of the layers.
+    /// @param layers number of layers.
+    /// @param padding texels kept free on each side of every rectangle.
+    /// @param alignment rectangles including their padding start at, and extend to, multiples of this.
+    AtlasPacker(GLsizei width, GLsizei height, GLsizei layers, GLsizei padding = 0, GLsizei alignment = 1);
+
+    /// Find room for a @p width x @p height rectangle.
+    /**
+     * @return the position of the rectangle, without its padding, or std::nullopt if there isn't enough free space.
+     */
+    [[nodiscard]]
+    auto insert(GLsizei width, GLsizei height) -> std::optional<Rect>;
+
+    /// Free the space of @p rect, which must have been returned by insert() and not removed yet.
+    void remove(const Rect &rect);
+
+    /// Number of free texels, summed over all layers.
+    [[nodiscard]]
+    auto getFreeArea() const -> std::int64_t;
+
+    /// Number of free rectangles; a measure of fragmentation.
+    [[nodiscard]]
+    auto getFreeRectCount() const -> std::size_t
+    { return m_free.size(); }
+
+    [[nodiscard]]
+    auto getWidth() const -> GLsizei
+    { return m_width; }
+
+    [[nodiscard]]
+    auto getHeight() const -> GLsizei
+    { return m_height; }
+
+    [[nodiscard]]
+    auto getLayers() const -> GLsizei
+    { return m_layers; }
+
+    [[nodiscard]]
+    auto getPadding() const -> GLsizei
+    { return m_padding; }
+
+private:
+    // size of the cell taken by a rectangle, including its padding
+    [[nodiscard]]
+    auto getCellSize(GLsizei size) const -> GLsizei;
+
+    void addFree(Rect rect);
+
+    GLsizei m_width;
+    GLsizei m_height;
+    GLsizei m_layers;
+    GLsizei m_padding;
+    GLsizei m_alignment;
+
+    std::vector<Rect> m_free;
+    // number of inserted rectangles per layer
+    std::vector<GLsizei> m_rect_counts;
+};
+
+/// Images packed into the layers of a 2D array texture, to be sampled without rebinding.
+/**
+ * Each image is surrounded by padding texels which repeat its edges, so filtering at its border doesn't pick up its
+ * neighbours. Padding and positions are scaled by 2^(levels - 1), so images stay apart, with the same padding, at
+ * every mipmap level.
+ */
+class TextureAtlas
+{
+public:
+    /// Where an image was placed.
+    struct Entry
+    {
+        AtlasPacker::Rect rect;
+        /// texture coordinates of the corners of the image
+        glm::vec2 uv_min{0.0f, 0.0f};
+        glm::vec2 uv_max{0.0f, 0.0f};
+    };
+
+    /// Create the array texture.
+    /**
+     * @param padding texels around each image at the smallest mipmap level; 2^(levels - 1) times as many at level 0.
+     */
+    TextureAtlas(TextureHandle::SizedInternalFormat internal_format, GLsizei width, GLsizei height, GLsizei layers,
+                 GLsizei levels = 1, GLsizei padding = 1);
+
+    /// Pack and upload an image.
+    /**
+     * Only level 0 is written; call generateMipmap() after adding images. Rows are padded to GL_UNPACK_ALIGNMENT; the
+     * other unpack state (GL_UNPACK_ROW_LENGTH...) must have its initial value.
+     * @param pixels @p width x @p height pixels, with tightly packed rows.
+     * @return where the image was placed, or std::nullopt if it doesn't fit.
+     */
+    [[nodiscard]]
+    auto add(GLsizei width, GLsizei height, TextureHandle::DataFormat format, TextureHandle::DataType type,
+             const void *pixels) -> std::optional<Entry>;
+
+    /// Free the space of @p entry for later images. The texels are left as they are.
+    void remove(const Entry &entry)
+    { m_packer.remove(entry.rect); }
+
+    /// Update the mipmaps of all layers.
+    void generateMipmap() const
+    { m_texture.generateMipmap(); }
+
+    [[nodiscard]]
+    auto getTexture() const -> TextureHandle
+    { return m_texture; }
+
+    [[nodiscard]]
+    auto getPacker() const -> const AtlasPacker &
+    { return m_packer; }
+
+private:
+    Texture m_texture;
+    AtlasPacker m_packer;
+    std::vector<std::uint8_t> m_staging;
+};
+
+} // GL
+
+#endif //GLUTILS_TEXTURE_ATLAS_HPP
@@ -0,0 +1,131 @@
+#ifndef GLUTILS_TEXTURE_BINDING_TRACKER_HPP
+#define GLUTILS_TEXTURE_BINDING_TRACKER_HPP
+
+#include "sampler.hpp"
+#include "texture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace GL {
+
+/// Binds textures, samplers and images to their units in batches, skipping units which already hold them.
+/**
+ * setTexture() and setImage() only record what each unit should hold. flush() compares that with what the tracker
+ * last bound, and binds each run of consecutive changed units with one glBindTextures, glBindSamplers or
+ * glBindImageTextures call.
+ *
+ * The tracker assumes it is the only code binding textures, samplers and images. Call invalidate() after other code
+ * changed them, e.g. a GL_ARB_multi_bind-unaware library.
+ */
+class TextureBindingTracker
+{
+public:
+    enum class ImageAccess : GLenum
+    {
+        read_only = 0x88B8,
+        write_only = 0x88B9,
+        read_write = 0x88BA,
+    };
+
+    /// Track Limits::max_combined_texture_image_units texture units and Limits::max_image_units image units.
+    TextureBindingTracker();
+
+    /// Bind @p texture and @p sampler to texture unit @p unit at the next flush().
+    /**
+     * A zero texture handle unbinds the unit, a zero sampler handle makes the texture's own parameters apply.
+     */
+    void setTexture(GLuint unit, TextureHandle texture, SamplerHandle sampler = {});
+
+    /// Bind level 0 of @p texture, all its layers, for reading and writing in its own format at the next flush().
+    /**
+     * These are the bindings glBindImageTextures makes, so consecutive units set this way are bound with one call.
+     */
+    void setImage(GLuint unit, TextureHandle texture);
+
+    /// Bind one level or layer of @p texture to image unit @p unit at the next flush(), with glBindImageTexture.
+    /**
+     * @param layer the layer to bind, or -1 for all layers.
+     */
+    void setImage(GLuint unit, TextureHandle texture, GLint level, GLint layer, ImageAccess access,
+                  TextureHandle::SizedInternalFormat format);
+
+    /// Issue the binds of the units which changed since the last flush.
+    void flush();
+
+    /// Forget the bindings made, so the next flush() binds every unit set since.
+    void invalidate();
+
+    /// Number of bind calls made.
+    [[nodiscard]]
+    auto getIssuedCount() const -> std::size_t
+    { return m_issued_count; }
+
+    /// Number of units flush() found already holding what was set, and didn't bind again.
+    [[nodiscard]]
+    auto getElidedCount() const -> std::size_t
+    { return m_elided_count; }
+
+    /// Reset the counters, e.g. at the start of each frame.
+    void resetCounters()
+    {
+        m_issued_count = 0;
+        m_elided_count = 0;
+    }
+
+private:
+    // name of the bound object of a unit the tracker hasn't bound yet, or since invalidate()
+    static constexpr GLuint s_unknown = ~GLuint(0);
+
+    struct TextureUnit
+    {
+        GLuint texture{0};
+        GLuint sampler{0};
+    };
+
+    struct ImageUnit
+    {
+        GLuint texture{0};
+        GLint level{0};
+        GLint layer{-1};
+        ImageAccess access{ImageAccess::read_write};
+        TextureHandle::SizedInternalFormat format{};
+        // bound with glBindImageTextures, which chooses the format itself
+        bool whole{true};
+
+        bool operator==(const ImageUnit &other) const;
+    };
+
+    void flushTextures();
+
+    void flushImages();
+
+    void touchTexture(GLuint unit);
+
+    void touchImage(GLuint unit);
+
+    // what each unit should hold, what it holds, and whether it was set since the last flush
+    std::vector<TextureUnit> m_textures;
+    std::vector<TextureUnit> m_bound_textures;
+    std::vector<std::uint8_t> m_textures_touched;
+    // range of the units set since the last flush
+    GLuint m_textures_begin;
+    GLuint m_textures_end{0};
+
+    std::vector<ImageUnit> m_images;
+    std::vector<ImageUnit> m_bound_images;
+    std::vector<std::uint8_t> m_images_touched;
+    GLuint m_images_begin;
+    GLuint m_images_end{0};
+
+    // names of a run of units, kept to avoid allocating on every flush
+    std::vector<GLuint> m_names;
+
+    std::size_t m_issued_count{0};
+    std::size_t m_elided_count{0};
+};
+
+} // GL
+
+#endif //GLUTILS_TEXTURE_BINDING_TRACKER_HPP
@@ -0,0 +1,116 @@
+#ifndef GLUTILS_TEXTURE_CONTAINER_HPP
+#define GLUTILS_TEXTURE_CONTAINER_HPP
+
+#include "texture.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace GL {
+
+/// The layout of a KTX2 or DDS file in memory, parsed in place.
+/**
+ * Only the headers and level index are read: the images point into the memory they were parsed from, which must
+ * outlive the container, and can be uploaded from there without a copy.
+ *
+ * 2D, 2D array, cube map and 3D textures are supported, with uncompressed 8-bit, half and float formats or the BC,
+ * ETC2 and EAC block-compressed formats. KTX2 supercompression isn't supported.
+ */
+class TextureContainer
+{
+public:
+    /// A 2D image of one level: a layer, a face of a cube map (layer * 6 + face) or a slice of a 3D texture.
+    struct Image
+    {
+        GLint level{0};
+        /// z offset of the image in the level
+        GLint z{0};
+        GLsizei width{0};
+        GLsizei height{0};
+        const unsigned char *data{nullptr};
+        std::size_t size{0};
+    };
+
+    /// Parse the KTX2 or DDS file in @p data.
+    /**
+     * @throw GL::Error if the file is neither, is truncated, or uses an unsupported type or format.
+     */
+    TextureContainer(const unsigned char *data, std::size_t size);
+
+    [[nodiscard]]
+    auto getType() const -> TextureHandle::Type
+    { return m_type; }
+
+    [[nodiscard]]
+    auto getFormat() const -> TextureHandle::SizedInternalFormat
+    { return m_format; }
+
+    /// True if the format is block-compressed; then images are uploaded with updateCompressedImage2D().
+    [[nodiscard]]
+    bool isCompressed() const
+    { return TextureHandle::getBlockSize(m_format) != 0; }
+
+    /// Format of the pixels of uncompressed images.
+    [[nodiscard]]
+    auto getDataFormat() const -> TextureHandle::DataFormat
+    { return m_data_format; }
+
+    /// Type of the pixels of uncompressed images.
+    [[nodiscard]]
+    auto getDataType() const -> TextureHandle::DataType
+    { return m_data_type; }
+
+    [[nodiscard]]
+    auto getWidth() const -> GLsizei
+    { return m_width; }
+
+    [[nodiscard]]
+    auto getHeight() const -> GLsizei
+    { return m_height; }
+
+    /// Depth of a 3D texture, number of layers of an array, 6 for a cube map, else 1.
+    [[nodiscard]]
+    auto getDepth() const -> GLsizei
+    { return m_depth; }
+
+    [[nodiscard]]
+    auto getLevels() const -> GLsizei
+    { return m_levels; }
+
+    /// Size in bytes of a row of @p width pixels, or of a row of blocks @p width pixels wide.
+    [[nodiscard]]
+    auto getRowSize(GLsizei width) const -> std::size_t;
+
+    /// All images, smallest level first.
+    [[nodiscard]]
+    auto getImages() const -> const std::vector<Image> &
+    { return m_images; }
+
+private:
+    void parseKTX2(const unsigned char *data, std::size_t size);
+
+    void parseDDS(const unsigned char *data, std::size_t size);
+
+    void setType(GLsizei layers, bool array, GLsizei faces, bool volume);
+
+    // size in bytes of an image of @p level
+    [[nodiscard]]
+    auto getImageSize(GLint level) const -> std::size_t;
+
+    TextureHandle::Type m_type{TextureHandle::Type::_2d};
+    TextureHandle::SizedInternalFormat m_format{TextureHandle::SizedInternalFormat::rgba8};
+    TextureHandle::DataFormat m_data_format{TextureHandle::DataFormat::rgba};
+    TextureHandle::DataType m_data_type{TextureHandle::DataType::ubyte};
+    GLsizei m_pixel_size{0};
+
+    GLsizei m_width{0};
+    GLsizei m_height{0};
+    GLsizei m_depth{1};
+    GLsizei m_levels{1};
+
+    std::vector<Image> m_images;
+};
+
+} // GL
+
+#endif //GLUTILS_TEXTURE_CONTAINER_HPP
@@ -0,0 +1,127 @@
+#ifndef GLUTILS_TEXTURE_READBACK_HPP
+#define GLUTILS_TEXTURE_READBACK_HPP
+
+#include "buffer.hpp"
+#include "sync.hpp"
+#include "texture.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace GL {
+
+/// Reads texture images back through a ring of persistently mapped pixel pack buffer memory, without stalling.
+/**
+ * request() copies a region of a texture into the ring with glGetTextureSubImage and places a fence after the copy.
+ * poll() returns the readbacks whose fence has signaled, as pointers into the mapped buffer, so the pixels can be
+ * handed to an encoder or written to disk without another copy. Their memory stays valid until release(), which may
+ * be called from any thread.
+ *
+ * The buffer is allocated with GL_CLIENT_STORAGE_BIT, which asks for memory the CPU reads quickly.
+ *
+ * Memory is released in the order it was requested, so a readback that is never released stalls the ring. For
+ * continuous capture, size the ring for a few frames: request() returns std::nullopt instead of waiting when the
+ * ring is full, and the caller may drop the frame.
+ */
+class TextureReadback
+{
+public:
+    using ReadbackId = std::uint64_t;
+
+    /// Pixels of a completed readback, in the mapped buffer.
+    struct Readback
+    {
+        ReadbackId id{0};
+        const void *data{nullptr};
+        GLsizeiptr size{0};
+        /// distance in bytes between the starts of consecutive rows
+        GLsizeiptr row_stride{0};
+        GLsizei width{0};
+        GLsizei height{0};
+        GLsizei depth{0};
+    };
+
+    /// Create the pixel pack buffer and map it.
+    /**
+     * @param capacity size of the buffer in bytes; the largest readback possible.
+     */
+    explicit TextureReadback(GLsizeiptr capacity);
+
+    TextureReadback(const TextureReadback &) = delete;
+
+    TextureReadback &operator=(const TextureReadback &) = delete;
+
+    /// Copy a region of @p texture into the ring, or return std::nullopt if there isn't enough free memory.
+    /**
+     * Must be called on the thread the context is current on. Rows are padded to GL_PACK_ALIGNMENT; the other pack
+     * state (GL_PACK_ROW_LENGTH, GL_PACK_SKIP_PIXELS...) must have its initial value. The pixel pack buffer binding is
+     * reset to zero.
+     * @throw GL::Error if the region is empty or exceeds the capacity.
+     */
+    [[nodiscard]]
+    auto request(TextureHandle texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                 GLsizei height, GLsizei depth, TextureHandle::DataFormat format, TextureHandle::DataType type)
+    -> std::optional<ReadbackId>;
+
+    /// Return the readbacks whose fence has signaled since the last call, in the order they were requested.
+    /**
+     * Must be called on the thread the context is current on. Never blocks, unless @p wait is true, in which case it
+     * waits for all requested readbacks.
+     */
+    [[nodiscard]]
+    auto poll(bool wait = false) -> std::vector<Readback>;
+
+    /// Make the memory of a readback returned by poll() available again.
+    /**
+     * Thread safe.
+     */
+    void release(ReadbackId id);
+
+    /// Number of readbacks requested but not yet released.
+    [[nodiscard]]
+    auto getPendingCount() const -> std::size_t;
+
+    [[nodiscard]]
+    auto getCapacity() const -> GLsizeiptr
+    { return m_capacity; }
+
+private:
+    enum class State
+    {
+        issued,
+        ready,
+        released,
+    };
+
+    struct Request
+    {
+        Readback readback;
+        GLintptr offset{0};
+        GLsizeiptr size{0};
+        State state{State::issued};
+
+        std::optional<Sync> fence;
+    };
+
+    auto allocate(GLsizeiptr size) -> std::optional<GLintptr>;
+
+    Buffer m_buffer;
+    GLsizeiptr m_capacity;
+    const std::byte *m_data{nullptr};
+
+    mutable std::mutex m_mutex;
+
+    // in the order their memory was allocated; the front one is released first
+    std::deque<Request> m_requests;
+    // end of the most recent allocation
+    GLintptr m_head{0};
+    ReadbackId m_next_id{1};
+};
+
+} // GL
+
+#endif //GLUTILS_TEXTURE_READBACK_HPP
@@ -0,0 +1,157 @@
+#ifndef GLUTILS_TEXTURE_STREAMER_HPP
+#define GLUTILS_TEXTURE_STREAMER_HPP
+
+#include "buffer.hpp"
+#include "sync.hpp"
+#include "texture.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace GL {
+
+/// Uploads texture images through a ring of persistently mapped pixel unpack buffer memory.
+/**
+ * Any thread may reserve staging memory, write pixels to it and submit it as an update of a texture image. The thread
+ * the context is current on only issues the copy commands, with issue(), which source the pixels from the buffer, so
+ * the driver doesn't copy them on that thread. A fence is placed after each copy; poll() reports the uploads whose
+ * fence has signaled and makes their staging memory available again.
+ *
+ * Staging memory is released in the order it was reserved, so an upload that is reserved but never submitted stalls
+ * the ring.
+ */
+class TextureStreamer
+{
+public:
+    using UploadId = std::uint64_t;
+
+    /// Staging memory for one upload.
+    struct Staging
+    {
+        UploadId id{0};
+        void *data{nullptr};
+        GLsizeiptr size{0};
+    };
+
+    /// Create the staging buffer and map it.
+    /**
+     * Must be called on the thread the context is current on.
+     * @param capacity size of the staging buffer in bytes; the largest upload possible.
+     */
+    explicit TextureStreamer(GLsizeiptr capacity);
+
+    TextureStreamer(const TextureStreamer &) = delete;
+
+    TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+    /// Reserve @p size bytes of staging memory, or return std::nullopt if there isn't enough free memory.
+    /**
+     * Thread safe.
+     * @throw GL::Error if @p size exceeds the capacity.
+     */
+    [[nodiscard]]
+    auto tryReserve(GLsizeiptr size) -> std::optional<Staging>;
+
+    /// Reserve @p size bytes of staging memory, waiting for poll() to release enough of it.
+    /**
+     * Thread safe, but must not be called on the thread that calls poll() if the ring may be full.
+     * @throw GL::Error if @p size exceeds the capacity.
+     */
+    [[nodiscard]]
+    auto reserve(GLsizeiptr size) -> Staging;
+
+    /// Submit the pixels written to @p staging as the new contents of a region of @p texture.
+    /**
+     * Thread safe. The copy happens at the next call to issue(). The pixel layout is the one described by the
+     * unpack state (GL_UNPACK_ALIGNMENT, GL_UNPACK_ROW_LENGTH...) at that time.
+     */
+    void submit(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset, GLint yoffset,
+                GLsizei width, GLsizei height, TextureHandle::DataFormat format, TextureHandle::DataType type);
+
+    /// Like submit(), for 1D textures.
+    void submit1D(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset, GLsizei width,
+                  TextureHandle::DataFormat format, TextureHandle::DataType type);
+
+    /// Like submit(), for 3D, 2D array and cube map textures; for the latter, @p zoffset selects the layer or face.
+    void submit3D(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset, GLint yoffset,
+                  GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, TextureHandle::DataFormat format,
+                  TextureHandle::DataType type);
+
+    /// Issue the copy commands of the submitted uploads, each followed by a fence.
+    /**
+     * Must be called on the thread the context is current on. The pixel unpack buffer binding is reset to zero.
+     */
+    void issue();
+
+    /// Release the staging memory of uploads whose fence has signaled, and return their ids. Never blocks.
+    /**
+     * Must be called on the thread the context is current on.
+     */
+    [[nodiscard]]
+    auto poll() -> std::vector<UploadId>;
+
+    /// Number of uploads reserved but not yet returned by poll().
+    [[nodiscard]]
+    auto getPendingCount() const -> std::size_t;
+
+    [[nodiscard]]
+    auto getCapacity() const -> GLsizeiptr
+    { return m_capacity; }
+
+private:
+    enum class State
+    {
+        reserved,
+        submitted,
+        issued,
+    };
+
+    struct Upload
+    {
+        UploadId id{0};
+        GLintptr offset{0};
+        GLsizeiptr size{0};
+        State state{State::reserved};
+
+        TextureHandle texture;
+        // 1, 2 or 3; selects glTextureSubImage1D, 2D or 3D
+        int dimensions{2};
+        GLint level{0};
+        GLint xoffset{0};
+        GLint yoffset{0};
+        GLint zoffset{0};
+        GLsizei width{0};
+        GLsizei height{0};
+        GLsizei depth{0};
+        TextureHandle::DataFormat format{};
+        TextureHandle::DataType type{};
+
+        std::optional<Sync> fence;
+    };
+
+    auto allocate(GLsizeiptr size) -> std::optional<Staging>;
+
+    void submit(const Staging &staging, const Upload &region);
+
+    Buffer m_buffer;
+    GLsizeiptr m_capacity;
+    std::byte *m_data{nullptr};
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_released;
+
+    // in the order their memory was reserved; the front one is released first
+    std::deque<Upload> m_uploads;
+    // end of the most recent reservation
+    GLintptr m_head{0};
+    UploadId m_next_id{1};
+};
+
+} // GL
+
+#endif //GLUTILS_TEXTURE_STREAMER_HPP
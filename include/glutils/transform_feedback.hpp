@@ -0,0 +1,134 @@
+#ifndef GLUTILS_TRANSFORM_FEEDBACK_HPP
+#define GLUTILS_TRANSFORM_FEEDBACK_HPP
+
+#include "buffer.hpp"
+#include "handle.hpp"
+#include "object.hpp"
+
+namespace GL {
+
+class TransformFeedbackHandle : public Handle
+{
+    using Handle::Handle;
+public:
+    static auto create() -> TransformFeedbackHandle;
+
+    static void destroy(TransformFeedbackHandle transform_feedback);
+
+    enum class PrimitiveMode : GLenum
+    {
+        points = 0x0000,
+        lines = 0x0001,
+        line_loop = 0x0002,
+        line_strip = 0x0003,
+        triangles = 0x0004,
+        triangle_strip = 0x0005,
+        triangle_fan = 0x0006,
+        lines_adjacency = 0x000A,
+        line_strip_adjacency = 0x000B,
+        triangles_adjacency = 0x000C,
+        triangle_strip_adjacency = 0x000D,
+        patches = 0x000E,
+    };
+
+    enum class Parameter : GLenum
+    {
+        paused = 0x8E23,
+        active = 0x8E24,
+    };
+
+    /// glGetTransformFeedbackiv — query the state of a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glGetTransformFeedback.xhtml
+    [[nodiscard]]
+    auto getParameter(Parameter parameter) const -> GLint;
+
+    /// glBindTransformFeedback — bind a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBindTransformFeedback.xhtml
+    void bind() const;
+
+    /// Bind the default transform feedback object.
+    static void unbind();
+
+    /// glTransformFeedbackBufferBase — bind a buffer object to a transform feedback buffer object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glTransformFeedbackBufferBase.xhtml
+    /**
+     * @param index index of the binding point; less than Limits::max_transform_feedback_buffers.
+     */
+    void bindBuffer(GLuint index, BufferHandle buffer) const;
+
+    /// glTransformFeedbackBufferRange — bind a range within a buffer object to a transform feedback buffer object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glTransformFeedbackBufferRange.xhtml
+    /**
+     * @param index index of the binding point; less than Limits::max_transform_feedback_buffers.
+     * @param offset byte offset of the range; a multiple of four.
+     * @param size size of the range in bytes; a multiple of four.
+     */
+    void bindBufferRange(GLuint index, BufferHandle buffer, GLintptr offset, GLsizeiptr size) const;
+
+    void bindBufferRange(GLuint index, BufferHandle buffer, BufferHandle::Range range) const
+    {
+        bindBufferRange(index, buffer, range.offset, range.size);
+    }
+
+    /// glBeginTransformFeedback — start capturing the outputs of the bound transform feedback object's program. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBeginTransformFeedback.xhtml
+    /**
+     * @param mode one of PrimitiveMode::points, lines or triangles. Draws must produce primitives of that type.
+     */
+    static void begin(PrimitiveMode mode);
+
+    /// glEndTransformFeedback — end transform feedback operations. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glBeginTransformFeedback.xhtml
+    static void end();
+
+    /// glPauseTransformFeedback — pause transform feedback operations. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glPauseTransformFeedback.xhtml
+    static void pause();
+
+    /// glResumeTransformFeedback — resume transform feedback operations. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glResumeTransformFeedback.xhtml
+    static void resume();
+
+    /// glDrawTransformFeedback — render primitives using a count derived from a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDrawTransformFeedback.xhtml
+    /**
+     * Draws as many vertices as were captured into stream 0 by the last begin()/end() pair, without reading the
+     * count back.
+     */
+    void draw(PrimitiveMode mode) const;
+
+    /// glDrawTransformFeedbackInstanced — render multiple instances of primitives using a count derived from a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDrawTransformFeedbackInstanced.xhtml
+    void drawInstanced(PrimitiveMode mode, GLsizei instance_count) const;
+
+    /// glDrawTransformFeedbackStream — render primitives using a count derived from a specified stream of a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDrawTransformFeedbackStream.xhtml
+    void drawStream(PrimitiveMode mode, GLuint stream) const;
+
+    /// glDrawTransformFeedbackStreamInstanced — render multiple instances of primitives using a count derived from a specified stream of a transform feedback object. https://registry.khronos.org/OpenGL-Refpages/gl4/html/glDrawTransformFeedbackStreamInstanced.xhtml
+    void drawStreamInstanced(PrimitiveMode mode, GLuint stream, GLsizei instance_count) const;
+};
+
+using TransformFeedback = Object<TransformFeedbackHandle>;
+
+/// Binds a transform feedback object and captures the outputs of the draws made during its lifetime.
+/**
+ * The constructor binds the object and begins transform feedback, the destructor ends it and binds the transform
+ * feedback object that was bound before. The program that captures must be in use before the scope is created, and its
+ * varyings set with ProgramHandle::setTransformFeedbackVaryings() before it was linked.
+ */
+class TransformFeedbackScope
+{
+public:
+    TransformFeedbackScope(TransformFeedbackHandle transform_feedback, TransformFeedbackHandle::PrimitiveMode mode);
+
+    ~TransformFeedbackScope();
+
+    TransformFeedbackScope(const TransformFeedbackScope &) = delete;
+
+    TransformFeedbackScope &operator=(const TransformFeedbackScope &) = delete;
+
+    /// Stop capturing, e.g. to draw with a program which doesn't output the captured varyings.
+    void pause()
+    { TransformFeedbackHandle::pause(); }
+
+    /// Capture again after pause().
+    void resume()
+    { TransformFeedbackHandle::resume(); }
+
+private:
+    GLuint m_previous{0};
+};
+
+} // GL
+
+#endif //GLUTILS_TRANSFORM_FEEDBACK_HPP
@@ -0,0 +1,154 @@
+#ifndef GLUTILS_UNIFORM_BLOCK_WRITER_HPP
+#define GLUTILS_UNIFORM_BLOCK_WRITER_HPP
+
+#include "buffer.hpp"
+#include "program.hpp"
+#include "program_reflection.hpp"
+
+#include "glm/fwd.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace GL {
+
+/// A CPU-side image of a uniform block, uploaded to a buffer with a single write.
+/**
+ * The layout (size, member offsets and strides) is taken from the program's reflection, so it matches std140,
+ * shared or packed blocks alike. Members are set by name hash or by offset; only the span of bytes that changed since
+ * the last upload is written. Member names are the ones GL reports, so "BlockName.member" for blocks declared with an
+ * instance name and "member" otherwise.
+ */
+class UniformBlockWriter
+{
+public:
+    /// Create an image of the uniform block with name hash @p block_key.
+    /**
+     * @throw GL::Error if the program has no active uniform block with that name.
+     */
+    UniformBlockWriter(const ProgramReflection &reflection, std::uint64_t block_key);
+
+    /// Index of the block within the program's uniform_block interface.
+    [[nodiscard]]
+    auto getBlockIndex() const -> GLuint
+    { return m_block_index; }
+
+    /// Size of the block in bytes.
+    [[nodiscard]]
+    auto getSize() const -> GLsizeiptr
+    { return static_cast<GLsizeiptr>(m_data.size()); }
+
+    /// Byte offset of the member with name hash @p key, or -1 if the block has no such member.
+    [[nodiscard]]
+    auto getOffset(std::uint64_t key) const -> GLint;
+
+    /// Set a scalar or vector member.
+    /**
+     * bool and glm::bvec values are written as 32-bit 0 or 1 per component, the size GLSL gives them.
+     */
+    template<typename T>
+    void set(std::uint64_t key, const T &value)
+    {
+        const auto member = findMember(key);
+        if (!member)
+            return;
+
+        const typename BlockValue<T>::type block_value(value);
+        write(member->offset, &block_value, sizeof(block_value));
+    }
+
+    /// Set a matrix member, one column at a time to respect the member's matrix stride.
+    template<int C, int R, typename T, glm::qualifier Q>
+    void set(std::uint64_t key, const glm::mat<C, R, T, Q> &value)
+    {
+        const auto member = findMember(key);
+        if (member)
+            writeMatrix(member->offset, member->matrix_stride, value);
+    }
+
+    /// Set @p count consecutive elements of an array member, starting with element @p first.
+    template<typename T>
+    void setArray(std::uint64_t key, GLsizei first, GLsizei count, const T *values)
+    {
+        const auto member = findMember(key);
+        if (!member)
+            return;
+
+        for (GLsizei i = 0; i < count; i++)
+        {
+            const auto offset = member->offset + (first + i) * member->array_stride;
+
+            if constexpr (IsMatrix<T>::value)
+                writeMatrix(offset, member->matrix_stride, values[i]);
+            else
+            {
+                const typename BlockValue<T>::type block_value(values[i]);
+                write(offset, &block_value, sizeof(block_value));
+            }
+        }
+    }
+
+    /// Copy @p size bytes from @p data to @p offset within the block.
+    void write(GLint offset, const void *data, std::size_t size);
+
+    /// True if the image changed since the last upload.
+    [[nodiscard]]
+    bool isDirty() const
+    { return m_dirty_begin < m_dirty_end; }
+
+    /// Write the changed bytes to @p buffer, where the block starts at @p buffer_offset. One BufferHandle::write().
+    void upload(BufferHandle buffer, GLintptr buffer_offset = 0);
+
+    /// Copy the changed bytes to @p mapped, a pointer to where the block starts in a mapped buffer.
+    void upload(void *mapped);
+
+    /// Mark the whole block as changed, e.g. after switching to a buffer which doesn't hold the current image yet.
+    void markDirty();
+
+    /// Bind the block of @p program to @p binding, and bind @p buffer's range holding the block to it.
+    void bind(ProgramHandle program, GLuint binding, BufferHandle buffer, GLintptr buffer_offset = 0) const;
+
+private:
+    struct Member
+    {
+        std::uint64_t key;
+        GLint offset;
+        GLint array_stride;
+        GLint matrix_stride;
+    };
+
+    template<typename T>
+    struct IsMatrix : std::false_type {};
+
+    template<int C, int R, typename T, glm::qualifier Q>
+    struct IsMatrix<glm::mat<C, R, T, Q>> : std::true_type {};
+
+    // the type a value is stored as in the block; GLSL bools are 32 bits wide
+    template<typename T>
+    struct BlockValue { using type = std::conditional_t<std::is_same_v<T, bool>, GLuint, T>; };
+
+    template<int L, glm::qualifier Q>
+    struct BlockValue<glm::vec<L, bool, Q>> { using type = glm::vec<L, GLuint, Q>; };
+
+    [[nodiscard]] auto findMember(std::uint64_t key) const -> const Member *;
+
+    template<int C, int R, typename T, glm::qualifier Q>
+    void writeMatrix(GLint offset, GLint matrix_stride, const glm::mat<C, R, T, Q> &value)
+    {
+        for (int column = 0; column < C; column++)
+            write(offset + column * matrix_stride, &value[column], R * sizeof(T));
+    }
+
+    GLuint m_block_index;
+    std::vector<Member> m_members; // sorted by key
+    std::vector<unsigned char> m_data;
+    std::size_t m_dirty_begin{0};
+    std::size_t m_dirty_end{0};
+};
+
+} // GL
+
+#endif //GLUTILS_UNIFORM_BLOCK_WRITER_HPP
@@ -0,0 +1,109 @@
+#ifndef GLUTILS_UNIFORM_SHADOW_HPP
+#define GLUTILS_UNIFORM_SHADOW_HPP
+
+#include "program.hpp"
+#include "program_reflection.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace GL {
+
+/// Sets the uniforms of a program, skipping calls that wouldn't change their value.
+/**
+ * Keeps a copy of the last value written to each uniform location, laid out from the program's reflection. Each
+ * setUniform*() call compares the new value with the copy and only calls glProgramUniform* if they differ.
+ * Uniforms written through other means (e.g. ProgramHandle::setUniform(), or relinking the program) aren't seen by
+ * the shadow; call invalidate() afterwards.
+ */
+class UniformShadow
+{
+public:
+    UniformShadow(ProgramHandle program, const ProgramReflection &reflection);
+
+    [[nodiscard]]
+    auto getProgram() const -> ProgramHandle
+    { return m_program; }
+
+    /// Same as ProgramHandle::setUniform(GLint, T), skipped if @p value is already set.
+    template<typename T>
+    void setUniform(GLint location, T value)
+    {
+        if (update(location, 1, &value, sizeof(T)))
+            m_program.setUniform(location, value);
+    }
+
+    /// Same as ProgramHandle::setUniform(GLint, GLsizei, const T *), skipped if @p values are already set.
+    template<typename T>
+    void setUniform(GLint location, GLsizei count, const T *values)
+    {
+        if (update(location, count, values, sizeof(T)))
+            m_program.setUniform(location, count, values);
+    }
+
+    /// Same as ProgramHandle::setUniformMatrix(), skipped if @p values are already set.
+    /**
+     * Transposed values are always written, since their layout differs from what is stored for untransposed ones.
+     */
+    template<typename T>
+    void setUniformMatrix(GLint location, GLsizei count, GLboolean transpose, const T *values)
+    {
+        if (transpose)
+        {
+            forget(location, count);
+            m_issued_count++;
+        }
+        else if (!update(location, count, values, sizeof(T)))
+        {
+            return;
+        }
+
+        m_program.setUniformMatrix(location, count, transpose, values);
+    }
+
+    /// Forget all stored values, so that the next write to every location is issued.
+    void invalidate();
+
+    /// Number of glProgramUniform* calls that were made.
+    [[nodiscard]]
+    auto getIssuedCount() const -> std::size_t
+    { return m_issued_count; }
+
+    /// Number of calls that were skipped because the value was already set.
+    [[nodiscard]]
+    auto getSkippedCount() const -> std::size_t
+    { return m_skipped_count; }
+
+    void resetCounters()
+    {
+        m_issued_count = 0;
+        m_skipped_count = 0;
+    }
+
+private:
+    struct Slot
+    {
+        std::size_t offset{0};
+        std::size_t size{0};
+        bool known{false};
+    };
+
+    /// Compare and store the value. Returns true if it has to be written, and counts the call either way.
+    bool update(GLint location, GLsizei count, const void *data, std::size_t element_size);
+
+    void forget(GLint location, GLsizei count);
+
+    ProgramHandle m_program;
+    std::vector<Slot> m_slots; // indexed by location
+    std::vector<unsigned char> m_values;
+    std::size_t m_issued_count{0};
+    std::size_t m_skipped_count{0};
+};
+
+/// Size in bytes of a value of the GLSL type @p type (e.g. GL_FLOAT_MAT4) as passed to glProgramUniform*.
+[[nodiscard]]
+auto getUniformTypeSize(GLenum type) -> std::size_t;
+
+} // GL
+
+#endif //GLUTILS_UNIFORM_SHADOW_HPP
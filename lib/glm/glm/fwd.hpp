@@ -0,0 +1,10 @@
+#pragma once
+namespace glm {
+enum qualifier { packed_highp, defaultp = packed_highp };
+template<int L, typename T, qualifier Q = defaultp> struct vec;
+template<int C, int R, typename T, qualifier Q = defaultp> struct mat;
+}
+namespace glm {
+using vec2 = vec<2, float>; using vec3 = vec<3, float>; using vec4 = vec<4, float>;
+using mat4 = mat<4, 4, float>;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include "../fwd.hpp"
+namespace glm {
+template<typename T, qualifier Q> struct vec<1, T, Q> { T x; };
+template<typename T, qualifier Q> struct vec<2, T, Q> { T x, y; };
+template<typename T, qualifier Q> struct vec<3, T, Q> { T x, y, z; };
+template<typename T, qualifier Q> struct vec<4, T, Q> { T x, y, z, w; };
+template<int C, int R, typename T, qualifier Q> struct mat { vec<R, T, Q> value[C]; vec<R,T,Q> &operator[](int i){return value[i];} const vec<R,T,Q> &operator[](int i) const {return value[i];} };
+template<int L, typename T, qualifier Q> const T *value_ptr(const vec<L, T, Q> &v) { return &v.x; }
+template<int C, int R, typename T, qualifier Q> const T *value_ptr(const mat<C, R, T, Q> &m) { return &m.value[0].x; }
+}
@@ -0,0 +1,2 @@
+#pragma once
+#include "gtc/type_ptr.hpp"
@@ -0,0 +1,83 @@
+#include "glutils/barrier_tracker.hpp"
+#include "glutils/gl.hpp"
+
+namespace GL {
+
+namespace {
+
+constexpr std::uint64_t texture_key_bit = std::uint64_t(1) << 32;
+
+} // namespace
+
+void BarrierTracker::write(BufferHandle buffer)
+{
+    write(buffer.getName());
+}
+
+void BarrierTracker::write(TextureHandle texture)
+{
+    write(texture.getName() | texture_key_bit);
+}
+
+void BarrierTracker::use(BufferHandle buffer, Access access)
+{
+    use(buffer.getName(), static_cast<GLbitfield>(access));
+}
+
+void BarrierTracker::use(TextureHandle texture, Access access)
+{
+    use(texture.getName() | texture_key_bit, static_cast<GLbitfield>(access));
+}
+
+void BarrierTracker::flush()
+{
+    if (m_pending == 0)
+        return;
+
+    glMemoryBarrier(m_pending);
+    m_issued_count++;
+
+    for (std::size_t bit = 0; bit < s_bit_count; bit++)
+    {
+        if (m_pending & (1u << bit))
+            m_synced[bit] = m_serial;
+    }
+    m_pending = 0;
+}
+
+void BarrierTracker::clear()
+{
+    m_writes.clear();
+    m_synced.fill(m_serial);
+    m_pending = 0;
+}
+
+void BarrierTracker::write(std::uint64_t key)
+{
+    m_writes[key] = ++m_serial;
+}
+
+void BarrierTracker::use(std::uint64_t key, GLbitfield access)
+{
+    const auto iter = m_writes.find(key);
+    const GLbitfield needed = iter == m_writes.end() ? 0 : access & ~m_pending;
+
+    GLbitfield added = 0;
+    for (std::size_t bit = 0; bit < s_bit_count; bit++)
+    {
+        if ((needed & (1u << bit)) && m_synced[bit] < iter->second)
+            added |= 1u << bit;
+    }
+
+    if (added == 0)
+        m_elided_count++;
+
+    m_pending |= added;
+}
+
+auto operator|(BarrierTracker::Access l, BarrierTracker::Access r) -> BarrierTracker::Access
+{
+    return static_cast<BarrierTracker::Access>(static_cast<GLbitfield>(l) | static_cast<GLbitfield>(r));
+}
+
+} // GL
@@ -0,0 +1,208 @@
+#include "glutils/bindless_texture_manager.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace GL {
+
+struct BindlessTextureManager::Procs
+{
+    GLuint64 (GLAD_API_PTR *get_texture_handle)(GLuint texture);
+    GLuint64 (GLAD_API_PTR *get_texture_sampler_handle)(GLuint texture, GLuint sampler);
+    void (GLAD_API_PTR *make_resident)(GLuint64 handle);
+    void (GLAD_API_PTR *make_non_resident)(GLuint64 handle);
+};
+
+BindlessTextureManager::BindlessTextureManager(GLsizeiptr budget, GLuint capacity, const ArrayFallback &fallback)
+        : m_budget(budget), m_slots(capacity), m_fallback(fallback), m_entries(capacity, 0), m_dirty_begin(capacity)
+{
+    if (getLimits().hasExtension("GL_ARB_bindless_texture"))
+    {
+        m_procs = std::make_unique<Procs>();
+        m_procs->get_texture_handle = reinterpret_cast<decltype(Procs::get_texture_handle)>(
+                getProcAddress("glGetTextureHandleARB"));
+        m_procs->get_texture_sampler_handle = reinterpret_cast<decltype(Procs::get_texture_sampler_handle)>(
+                getProcAddress("glGetTextureSamplerHandleARB"));
+        m_procs->make_resident = reinterpret_cast<decltype(Procs::make_resident)>(
+                getProcAddress("glMakeTextureHandleResidentARB"));
+        m_procs->make_non_resident = reinterpret_cast<decltype(Procs::make_non_resident)>(
+                getProcAddress("glMakeTextureHandleNonResidentARB"));
+
+        m_bindless = m_procs->get_texture_handle && m_procs->get_texture_sampler_handle && m_procs->make_resident
+                     && m_procs->make_non_resident;
+    }
+
+    if (!m_bindless)
+    {
+        m_array = TextureHandle::create(TextureHandle::Type::_2d_array);
+        m_array.setStorage3D(fallback.levels, fallback.format, fallback.width, fallback.height, fallback.layers);
+
+        m_budget = fallback.layers;
+        for (GLint layer = fallback.layers - 1; layer >= 0; layer--)
+            m_free_layers.push_back(layer);
+
+        std::fill(m_entries.begin(), m_entries.end(), non_resident_layer);
+    }
+
+    m_table.allocateImmutable(GLsizeiptr(capacity) * sizeof(GLuint64), BufferHandle::StorageFlags::dynamic_storage,
+                              m_entries.data());
+
+    for (GLuint slot = capacity; slot > 0; slot--)
+        m_free_slots.push_back(slot - 1);
+}
+
+BindlessTextureManager::~BindlessTextureManager()
+{
+    // handles stay resident after their textures are deleted until the context is destroyed
+    while (!m_lru.empty())
+        makeNonResident(m_lru.front());
+}
+
+auto BindlessTextureManager::add(TextureHandle texture, GLsizeiptr size, SamplerHandle sampler) -> GLuint
+{
+    if (m_free_slots.empty())
+        throw Error("all bindless texture slots are in use");
+
+    const auto slot = m_free_slots.back();
+    m_free_slots.pop_back();
+
+    auto &entry = m_slots[slot];
+    entry = {};
+    entry.texture = texture;
+    entry.used = true;
+
+    if (m_bindless)
+    {
+        entry.size = size;
+        entry.handle = sampler ? m_procs->get_texture_sampler_handle(texture.getName(), sampler.getName())
+                               : m_procs->get_texture_handle(texture.getName());
+        setEntry(slot, entry.handle);
+    }
+    else
+    {
+        entry.size = 1;
+    }
+
+    return slot;
+}
+
+void BindlessTextureManager::remove(GLuint slot)
+{
+    if (slot >= m_slots.size())
+        throw Error("bindless texture slot " + std::to_string(slot) + " is out of range");
+
+    auto &entry = m_slots[slot];
+    if (!entry.used)
+        return;
+
+    if (entry.resident)
+        makeNonResident(slot);
+
+    entry = {};
+    setEntry(slot, m_bindless ? 0 : non_resident_layer);
+    m_free_slots.push_back(slot);
+}
+
+void BindlessTextureManager::use(GLuint slot)
+{
+    if (slot >= m_slots.size() || !m_slots[slot].used)
+        throw Error("bindless texture slot " + std::to_string(slot) + " holds no texture");
+
+    auto &entry = m_slots[slot];
+    entry.last_frame = m_frame;
+
+    if (entry.resident)
+    {
+        m_lru.splice(m_lru.begin(), m_lru, entry.lru);
+        return;
+    }
+
+    // evict before making the texture resident, so the fallback has a free layer
+    while (!m_lru.empty() && m_resident_size + entry.size > m_budget)
+    {
+        const auto victim = m_lru.back();
+        if (m_slots[victim].last_frame == m_frame)
+            break;
+
+        makeNonResident(victim);
+        m_eviction_count++;
+    }
+
+    makeResident(slot);
+}
+
+void BindlessTextureManager::flush()
+{
+    if (m_dirty_begin >= m_dirty_end)
+        return;
+
+    m_table.write(GLintptr(m_dirty_begin) * sizeof(GLuint64),
+                  GLsizeiptr(m_dirty_end - m_dirty_begin) * sizeof(GLuint64), m_entries.data() + m_dirty_begin);
+
+    m_dirty_begin = static_cast<GLuint>(m_entries.size());
+    m_dirty_end = 0;
+}
+
+void BindlessTextureManager::makeResident(GLuint slot)
+{
+    auto &entry = m_slots[slot];
+
+    if (m_bindless)
+    {
+        m_procs->make_resident(entry.handle);
+    }
+    else
+    {
+        if (m_free_layers.empty())
+            throw Error("all layers of the texture array are used in the current frame");
+
+        entry.layer = m_free_layers.back();
+        m_free_layers.pop_back();
+
+        for (GLint level = 0; level < m_fallback.levels; level++)
+        {
+            glCopyImageSubData(entry.texture.getName(), GL_TEXTURE_2D, level, 0, 0, 0,
+                               m_array.getName(), GL_TEXTURE_2D_ARRAY, level, 0, 0, entry.layer,
+                               std::max(m_fallback.width >> level, 1), std::max(m_fallback.height >> level, 1), 1);
+        }
+
+        setEntry(slot, GLuint64(entry.layer));
+    }
+
+    entry.resident = true;
+    entry.lru = m_lru.insert(m_lru.begin(), slot);
+    m_resident_size += entry.size;
+}
+
+void BindlessTextureManager::makeNonResident(GLuint slot)
+{
+    auto &entry = m_slots[slot];
+
+    if (m_bindless)
+    {
+        m_procs->make_non_resident(entry.handle);
+    }
+    else
+    {
+        // the layer is reused by another texture, which shaders must not read through this slot
+        m_free_layers.push_back(entry.layer);
+        entry.layer = -1;
+        setEntry(slot, non_resident_layer);
+    }
+
+    entry.resident = false;
+    m_lru.erase(entry.lru);
+    m_resident_size -= entry.size;
+}
+
+void BindlessTextureManager::setEntry(GLuint slot, GLuint64 value)
+{
+    m_entries[slot] = value;
+    m_dirty_begin = std::min(m_dirty_begin, slot);
+    m_dirty_end = std::max(m_dirty_end, slot + 1);
+}
+
+} // GL
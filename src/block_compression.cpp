@@ -0,0 +1,624 @@
+#include "glutils/block_compression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define GLUTILS_BLOCK_COMPRESSION_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLUTILS_BLOCK_COMPRESSION_SSE2
+#endif
+
+namespace GL {
+
+namespace {
+
+/// The 16 pixels of a block, one array per channel, in the range [0, 255].
+struct Block
+{
+    alignas(32) float channels[4][16];
+};
+
+using Vector = std::array<float, 4>;
+
+void loadBlock(const std::uint8_t *pixels, GLsizei width, GLsizei height, GLsizei block_x, GLsizei block_y,
+               Block &block)
+{
+    for (int y = 0; y < 4; y++)
+    {
+        const auto source_y = std::min(block_y * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            const auto source_x = std::min(block_x * 4 + x, width - 1);
+            const auto pixel = pixels + (std::size_t(source_y) * width + source_x) * 4;
+            for (int channel = 0; channel < 4; channel++)
+                block.channels[channel][y * 4 + x] = float(pixel[channel]);
+        }
+    }
+}
+
+/// dots[i] = dot(pixel i - origin, axis)
+void project(const Block &block, const Vector &origin, const Vector &axis, float *dots)
+{
+#if defined(GLUTILS_BLOCK_COMPRESSION_AVX2)
+    for (int i = 0; i < 16; i += 8)
+    {
+        auto sum = _mm256_setzero_ps();
+        for (int channel = 0; channel < 4; channel++)
+        {
+            const auto values = _mm256_sub_ps(_mm256_load_ps(block.channels[channel] + i),
+                                              _mm256_set1_ps(origin[channel]));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(values, _mm256_set1_ps(axis[channel])));
+        }
+        _mm256_storeu_ps(dots + i, sum);
+    }
+#elif defined(GLUTILS_BLOCK_COMPRESSION_SSE2)
+    for (int i = 0; i < 16; i += 4)
+    {
+        auto sum = _mm_setzero_ps();
+        for (int channel = 0; channel < 4; channel++)
+        {
+            const auto values = _mm_sub_ps(_mm_load_ps(block.channels[channel] + i), _mm_set1_ps(origin[channel]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(values, _mm_set1_ps(axis[channel])));
+        }
+        _mm_storeu_ps(dots + i, sum);
+    }
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        float sum = 0.0f;
+        for (int channel = 0; channel < 4; channel++)
+            sum += (block.channels[channel][i] - origin[channel]) * axis[channel];
+        dots[i] = sum;
+    }
+#endif
+}
+
+/// indices[i] = clamp(round(values[i] * scale), 0, max)
+void quantize(const float *values, float scale, float max, std::int32_t *indices)
+{
+#if defined(GLUTILS_BLOCK_COMPRESSION_AVX2)
+    for (int i = 0; i < 16; i += 8)
+    {
+        auto scaled = _mm256_mul_ps(_mm256_loadu_ps(values + i), _mm256_set1_ps(scale));
+        scaled = _mm256_min_ps(_mm256_max_ps(scaled, _mm256_setzero_ps()), _mm256_set1_ps(max));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(indices + i), _mm256_cvtps_epi32(scaled));
+    }
+#elif defined(GLUTILS_BLOCK_COMPRESSION_SSE2)
+    for (int i = 0; i < 16; i += 4)
+    {
+        auto scaled = _mm_mul_ps(_mm_loadu_ps(values + i), _mm_set1_ps(scale));
+        scaled = _mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), _mm_set1_ps(max));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(indices + i), _mm_cvtps_epi32(scaled));
+    }
+#else
+    for (int i = 0; i < 16; i++)
+        indices[i] = static_cast<std::int32_t>(std::lround(std::clamp(values[i] * scale, 0.0f, max)));
+#endif
+}
+
+/// Fit a line through the pixels of @p block, using the channels whose @p mask is 1.
+/**
+ * The line goes through the mean along the principal axis, found by power iteration on the covariance matrix.
+ * @return the endpoints of the smallest segment of the line which the projections of all pixels fall on.
+ */
+auto fitEndpoints(const Block &block, const Vector &mask) -> std::array<Vector, 2>
+{
+    Vector mean{};
+    for (int channel = 0; channel < 4; channel++)
+    {
+        if (mask[channel] == 0.0f)
+            continue;
+        for (int i = 0; i < 16; i++)
+            mean[channel] += block.channels[channel][i];
+        mean[channel] /= 16.0f;
+    }
+
+    float covariance[4][4]{};
+    for (int i = 0; i < 16; i++)
+    {
+        Vector delta;
+        for (int channel = 0; channel < 4; channel++)
+            delta[channel] = (block.channels[channel][i] - mean[channel]) * mask[channel];
+        for (int row = 0; row < 4; row++)
+        {
+            for (int column = row; column < 4; column++)
+                covariance[row][column] += delta[row] * delta[column];
+        }
+    }
+
+    // start from the channel which varies most
+    Vector axis{};
+    int largest = 0;
+    for (int channel = 1; channel < 4; channel++)
+    {
+        if (covariance[channel][channel] > covariance[largest][largest])
+            largest = channel;
+    }
+    axis[largest] = 1.0f;
+
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        Vector next{};
+        for (int row = 0; row < 4; row++)
+        {
+            for (int column = 0; column < 4; column++)
+                next[row] += covariance[std::min(row, column)][std::max(row, column)] * axis[column];
+        }
+
+        const auto length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2]), std::abs(next[3])});
+        if (length == 0.0f)
+            return {mean, mean};
+
+        for (int channel = 0; channel < 4; channel++)
+            axis[channel] = next[channel] / length;
+    }
+
+    const auto length_squared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3];
+    for (auto &component: axis)
+        component /= std::sqrt(length_squared);
+
+    alignas(32) float dots[16];
+    project(block, mean, axis, dots);
+    const auto [min, max] = std::minmax_element(dots, dots + 16);
+
+    std::array<Vector, 2> endpoints;
+    for (int channel = 0; channel < 4; channel++)
+    {
+        endpoints[0][channel] = std::clamp(mean[channel] + axis[channel] * *min, 0.0f, 255.0f);
+        endpoints[1][channel] = std::clamp(mean[channel] + axis[channel] * *max, 0.0f, 255.0f);
+    }
+    return endpoints;
+}
+
+/// Choose for each pixel the nearest of @p steps + 1 colors evenly spaced from @p from to @p to.
+void selectIndices(const Block &block, const Vector &from, const Vector &to, int steps, std::int32_t *indices)
+{
+    Vector axis;
+    float length_squared = 0.0f;
+    for (int channel = 0; channel < 4; channel++)
+    {
+        axis[channel] = to[channel] - from[channel];
+        length_squared += axis[channel] * axis[channel];
+    }
+
+    if (length_squared == 0.0f)
+    {
+        std::fill(indices, indices + 16, 0);
+        return;
+    }
+
+    alignas(32) float dots[16];
+    project(block, from, axis, dots);
+    quantize(dots, float(steps) / length_squared, float(steps), indices);
+}
+
+auto to565(const Vector &color) -> std::uint16_t
+{
+    const auto r = static_cast<std::uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+    const auto g = static_cast<std::uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+    const auto b = static_cast<std::uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<std::uint16_t>(r << 11 | g << 5 | b);
+}
+
+auto from565(std::uint16_t color) -> std::array<int, 3>
+{
+    const int r = color >> 11 & 0x1F;
+    const int g = color >> 5 & 0x3F;
+    const int b = color & 0x1F;
+    return {r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2};
+}
+
+void compressBC1(const Block &block, std::uint8_t *output)
+{
+    const auto endpoints = fitEndpoints(block, {1.0f, 1.0f, 1.0f, 0.0f});
+
+    // the larger endpoint comes first, which selects the four color mode
+    auto color0 = to565(endpoints[1]);
+    auto color1 = to565(endpoints[0]);
+    if (color0 < color1)
+        std::swap(color0, color1);
+
+    std::uint32_t bits = 0;
+    if (color0 != color1)
+    {
+        const auto rgb0 = from565(color0);
+        const auto rgb1 = from565(color1);
+
+        std::int32_t steps[16];
+        selectIndices(block, {float(rgb0[0]), float(rgb0[1]), float(rgb0[2]), 0.0f},
+                      {float(rgb1[0]), float(rgb1[1]), float(rgb1[2]), 0.0f}, 3, steps);
+
+        // palette order: color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1
+        constexpr std::uint32_t palette_index[4] = {0, 2, 3, 1};
+        for (int i = 0; i < 16; i++)
+            bits |= palette_index[steps[i]] << (2 * i);
+    }
+
+    const std::uint8_t block_bytes[8] = {
+            std::uint8_t(color0), std::uint8_t(color0 >> 8), std::uint8_t(color1), std::uint8_t(color1 >> 8),
+            std::uint8_t(bits), std::uint8_t(bits >> 8), std::uint8_t(bits >> 16), std::uint8_t(bits >> 24)};
+    std::memcpy(output, block_bytes, sizeof(block_bytes));
+}
+
+void compressBC4(const Block &block, int channel, std::uint8_t *output)
+{
+    const auto [min, max] = std::minmax_element(block.channels[channel], block.channels[channel] + 16);
+
+    // the larger endpoint comes first, which selects the eight value mode
+    output[0] = static_cast<std::uint8_t>(*max);
+    output[1] = static_cast<std::uint8_t>(*min);
+
+    std::uint64_t bits = 0;
+    if (*max != *min)
+    {
+        Vector from{}, to{};
+        from[channel] = *min;
+        to[channel] = *max;
+
+        std::int32_t steps[16];
+        selectIndices(block, from, to, 7, steps);
+
+        // palette order: max, min, then from 6/7 max + 1/7 min down to 1/7 max + 6/7 min
+        for (int i = 0; i < 16; i++)
+        {
+            const auto index = steps[i] == 7 ? 0 : steps[i] == 0 ? 1 : 8 - steps[i];
+            bits |= std::uint64_t(index) << (3 * i);
+        }
+    }
+
+    for (int i = 0; i < 6; i++)
+        output[2 + i] = static_cast<std::uint8_t>(bits >> (8 * i));
+}
+
+/// Writes the fields of a 128-bit block, least significant bit first.
+class BitWriter
+{
+public:
+    explicit BitWriter(std::uint8_t *output) : m_output(output)
+    { std::memset(output, 0, 16); }
+
+    void write(std::uint32_t value, int bits)
+    {
+        for (int i = 0; i < bits; i++, m_position++)
+            m_output[m_position / 8] |= std::uint8_t((value >> i & 1) << (m_position % 8));
+    }
+
+private:
+    std::uint8_t *m_output;
+    int m_position{0};
+};
+
+class BitReader
+{
+public:
+    explicit BitReader(const std::uint8_t *input) : m_input(input)
+    {}
+
+    auto read(int bits) -> std::uint32_t
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < bits; i++, m_position++)
+            value |= std::uint32_t(m_input[m_position / 8] >> (m_position % 8) & 1) << i;
+        return value;
+    }
+
+private:
+    const std::uint8_t *m_input;
+    int m_position{0};
+};
+
+constexpr int bc7_weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// Quantize @p endpoint to 7 bits per channel and a p-bit shared by its channels, the representation of mode 6.
+void quantizeBC7(const Vector &endpoint, std::array<std::uint32_t, 4> &values, std::uint32_t &p_bit)
+{
+    float best_error = -1.0f;
+    for (std::uint32_t p = 0; p < 2; p++)
+    {
+        std::array<std::uint32_t, 4> candidate;
+        float error = 0.0f;
+        for (int channel = 0; channel < 4; channel++)
+        {
+            const auto value = std::clamp(std::lround((endpoint[channel] - float(p)) / 2.0f), 0L, 127L);
+            candidate[channel] = static_cast<std::uint32_t>(value);
+            const auto delta = float(value << 1 | p) - endpoint[channel];
+            error += delta * delta;
+        }
+
+        if (best_error < 0.0f || error < best_error)
+        {
+            best_error = error;
+            values = candidate;
+            p_bit = p;
+        }
+    }
+}
+
+void compressBC7(const Block &block, std::uint8_t *output)
+{
+    const auto endpoints = fitEndpoints(block, {1.0f, 1.0f, 1.0f, 1.0f});
+
+    std::array<std::uint32_t, 4> values[2];
+    std::uint32_t p_bits[2];
+    quantizeBC7(endpoints[0], values[0], p_bits[0]);
+    quantizeBC7(endpoints[1], values[1], p_bits[1]);
+
+    Vector colors[2];
+    for (int endpoint = 0; endpoint < 2; endpoint++)
+    {
+        for (int channel = 0; channel < 4; channel++)
+            colors[endpoint][channel] = float(values[endpoint][channel] << 1 | p_bits[endpoint]);
+    }
+
+    std::int32_t indices[16];
+    selectIndices(block, colors[0], colors[1], 15, indices);
+
+    // the most significant bit of the first index is implicitly 0
+    if (indices[0] & 8)
+    {
+        std::swap(values[0], values[1]);
+        std::swap(p_bits[0], p_bits[1]);
+        for (auto &index: indices)
+            index = 15 - index;
+    }
+
+    BitWriter writer(output);
+    writer.write(1 << 6, 7);
+    for (int channel = 0; channel < 4; channel++)
+    {
+        writer.write(values[0][channel], 7);
+        writer.write(values[1][channel], 7);
+    }
+    writer.write(p_bits[0], 1);
+    writer.write(p_bits[1], 1);
+    writer.write(static_cast<std::uint32_t>(indices[0]), 3);
+    for (int i = 1; i < 16; i++)
+        writer.write(static_cast<std::uint32_t>(indices[i]), 4);
+}
+
+auto getBlockBytes(BlockFormat format) -> std::size_t
+{
+    return format == BlockFormat::bc1 || format == BlockFormat::bc4 ? 8 : 16;
+}
+
+void compressRows(BlockFormat format, const std::uint8_t *pixels, GLsizei width, GLsizei height,
+                  std::uint8_t *blocks, GLsizei first_row, GLsizei last_row)
+{
+    const auto blocks_x = (width + 3) / 4;
+    const auto block_bytes = getBlockBytes(format);
+
+    Block block;
+    for (GLsizei block_y = first_row; block_y < last_row; block_y++)
+    {
+        auto output = blocks + std::size_t(block_y) * blocks_x * block_bytes;
+        for (GLsizei block_x = 0; block_x < blocks_x; block_x++, output += block_bytes)
+        {
+            loadBlock(pixels, width, height, block_x, block_y, block);
+
+            switch (format)
+            {
+                case BlockFormat::bc1:
+                    compressBC1(block, output);
+                    break;
+                case BlockFormat::bc4:
+                    compressBC4(block, 0, output);
+                    break;
+                case BlockFormat::bc5:
+                    compressBC4(block, 0, output);
+                    compressBC4(block, 1, output + 8);
+                    break;
+                case BlockFormat::bc7:
+                    compressBC7(block, output);
+                    break;
+            }
+        }
+    }
+}
+
+void decompressBC1(const std::uint8_t *input, std::uint8_t (*pixels)[4])
+{
+    const auto color0 = static_cast<std::uint16_t>(input[0] | input[1] << 8);
+    const auto color1 = static_cast<std::uint16_t>(input[2] | input[3] << 8);
+    const auto rgb0 = from565(color0);
+    const auto rgb1 = from565(color1);
+
+    std::uint8_t palette[4][3];
+    for (int channel = 0; channel < 3; channel++)
+    {
+        palette[0][channel] = std::uint8_t(rgb0[channel]);
+        palette[1][channel] = std::uint8_t(rgb1[channel]);
+        if (color0 > color1)
+        {
+            palette[2][channel] = std::uint8_t((2 * rgb0[channel] + rgb1[channel]) / 3);
+            palette[3][channel] = std::uint8_t((rgb0[channel] + 2 * rgb1[channel]) / 3);
+        }
+        else
+        {
+            palette[2][channel] = std::uint8_t((rgb0[channel] + rgb1[channel]) / 2);
+            palette[3][channel] = 0;
+        }
+    }
+
+    const auto bits = std::uint32_t(input[4]) | std::uint32_t(input[5]) << 8 | std::uint32_t(input[6]) << 16
+                      | std::uint32_t(input[7]) << 24;
+    for (int i = 0; i < 16; i++)
+    {
+        const auto &color = palette[bits >> (2 * i) & 3];
+        pixels[i][0] = color[0];
+        pixels[i][1] = color[1];
+        pixels[i][2] = color[2];
+        pixels[i][3] = 255;
+    }
+}
+
+void decompressBC4(const std::uint8_t *input, int channel, std::uint8_t (*pixels)[4])
+{
+    const int red0 = input[0];
+    const int red1 = input[1];
+
+    std::uint8_t palette[8] = {std::uint8_t(red0), std::uint8_t(red1)};
+    if (red0 > red1)
+    {
+        for (int i = 2; i < 8; i++)
+            palette[i] = std::uint8_t(((8 - i) * red0 + (i - 1) * red1) / 7);
+    }
+    else
+    {
+        for (int i = 2; i < 6; i++)
+            palette[i] = std::uint8_t(((6 - i) * red0 + (i - 1) * red1) / 5);
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 6; i++)
+        bits |= std::uint64_t(input[2 + i]) << (8 * i);
+
+    for (int i = 0; i < 16; i++)
+        pixels[i][channel] = palette[bits >> (3 * i) & 7];
+}
+
+void decompressBC7(const std::uint8_t *input, std::uint8_t (*pixels)[4])
+{
+    BitReader reader(input);
+    if (reader.read(7) != 1 << 6)
+    {
+        std::memset(pixels, 0, 16 * 4);
+        return;
+    }
+
+    std::uint32_t values[2][4];
+    for (int channel = 0; channel < 4; channel++)
+    {
+        values[0][channel] = reader.read(7);
+        values[1][channel] = reader.read(7);
+    }
+    const std::uint32_t p_bits[2] = {reader.read(1), reader.read(1)};
+
+    for (int i = 0; i < 16; i++)
+    {
+        const auto weight = bc7_weights[reader.read(i == 0 ? 3 : 4)];
+        for (int channel = 0; channel < 4; channel++)
+        {
+            const auto color0 = int(values[0][channel] << 1 | p_bits[0]);
+            const auto color1 = int(values[1][channel] << 1 | p_bits[1]);
+            pixels[i][channel] = std::uint8_t(((64 - weight) * color0 + weight * color1 + 32) >> 6);
+        }
+    }
+}
+
+} // namespace
+
+auto getInternalFormat(BlockFormat format) -> TextureHandle::SizedInternalFormat
+{
+    switch (format)
+    {
+        case BlockFormat::bc1:
+            return TextureHandle::SizedInternalFormat::compressed_rgb_s3tc_dxt1;
+        case BlockFormat::bc4:
+            return TextureHandle::SizedInternalFormat::compressed_red_rgtc1;
+        case BlockFormat::bc5:
+            return TextureHandle::SizedInternalFormat::compressed_rg_rgtc2;
+        case BlockFormat::bc7:
+        default:
+            return TextureHandle::SizedInternalFormat::compressed_rgba_bptc_unorm;
+    }
+}
+
+auto getCompressedSize(BlockFormat format, GLsizei width, GLsizei height) -> std::size_t
+{
+    return std::size_t((width + 3) / 4) * std::size_t((height + 3) / 4) * getBlockBytes(format);
+}
+
+void compressBlocks(BlockFormat format, const std::uint8_t *pixels, GLsizei width, GLsizei height,
+                    std::uint8_t *blocks, unsigned threads)
+{
+    if (width <= 0 || height <= 0)
+        return;
+
+    const auto rows = (height + 3) / 4;
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = std::min(threads, static_cast<unsigned>(rows));
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    // the calling thread compresses the first share of rows
+    for (unsigned thread = 1; thread < threads; thread++)
+    {
+        const auto first_row = static_cast<GLsizei>(std::int64_t(rows) * thread / threads);
+        const auto last_row = static_cast<GLsizei>(std::int64_t(rows) * (thread + 1) / threads);
+        workers.emplace_back(compressRows, format, pixels, width, height, blocks, first_row, last_row);
+    }
+
+    compressRows(format, pixels, width, height, blocks, 0, rows / static_cast<GLsizei>(threads));
+
+    for (auto &worker: workers)
+        worker.join();
+}
+
+auto compressBlocks(BlockFormat format, const std::uint8_t *pixels, GLsizei width, GLsizei height,
+                    unsigned threads) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> blocks(getCompressedSize(format, width, height));
+    compressBlocks(format, pixels, width, height, blocks.data(), threads);
+    return blocks;
+}
+
+void decompressBlocks(BlockFormat format, const std::uint8_t *blocks, GLsizei width, GLsizei height,
+                      std::uint8_t *pixels)
+{
+    const auto blocks_x = (width + 3) / 4;
+    const auto blocks_y = (height + 3) / 4;
+    const auto block_bytes = getBlockBytes(format);
+
+    std::uint8_t decoded[16][4];
+    for (GLsizei block_y = 0; block_y < blocks_y; block_y++)
+    {
+        for (GLsizei block_x = 0; block_x < blocks_x; block_x++, blocks += block_bytes)
+        {
+            switch (format)
+            {
+                case BlockFormat::bc1:
+                    decompressBC1(blocks, decoded);
+                    break;
+                case BlockFormat::bc4:
+                    std::memset(decoded, 0, sizeof(decoded));
+                    decompressBC4(blocks, 0, decoded);
+                    break;
+                case BlockFormat::bc5:
+                    std::memset(decoded, 0, sizeof(decoded));
+                    decompressBC4(blocks, 0, decoded);
+                    decompressBC4(blocks + 8, 1, decoded);
+                    break;
+                case BlockFormat::bc7:
+                    decompressBC7(blocks, decoded);
+                    break;
+            }
+
+            if (format == BlockFormat::bc4 || format == BlockFormat::bc5)
+            {
+                for (auto &pixel: decoded)
+                    pixel[3] = 255;
+            }
+
+            for (int y = 0; y < 4 && block_y * 4 + y < height; y++)
+            {
+                for (int x = 0; x < 4 && block_x * 4 + x < width; x++)
+                {
+                    const auto pixel = pixels + (std::size_t(block_y * 4 + y) * width + block_x * 4 + x) * 4;
+                    std::memcpy(pixel, decoded[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+}
+
+} // GL
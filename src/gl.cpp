@@ -1,5 +1,6 @@
 #include "glutils/gl.hpp"
 #include "glutils/error.hpp"
+#include "glutils/limits.hpp"
 
 #if GLUTILS_DEBUG
 
@@ -9,6 +10,13 @@
 
 namespace GL {
 
+namespace {
+
+Limits g_limits;
+GLADloadfunc g_loader{nullptr};
+
+} // namespace
+
 #if GLUTILS_DEBUG
 namespace {
 
@@ -120,9 +128,22 @@ int loadContext(GLADloadfunc loader)
     gladSetGLPostCallback(postCall);
 #endif // GLUTILS_DEBUG
 
+    g_loader = loader;
+    g_limits = queryLimits();
+
     return version;
 }
 
+auto getProcAddress(const char *name) -> GLADapiproc
+{
+    return g_loader ? g_loader(name) : nullptr;
+}
+
+auto getLimits() -> const Limits &
+{
+    return g_limits;
+}
+
 #if GLUTILS_DEBUG
 
 void enableDebugMessages(std::ostream *out, std::ostream *err)
@@ -0,0 +1,653 @@
+#include "glutils/gpu_primitives.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace GL {
+
+namespace {
+
+constexpr GLuint radix_bits = 4;
+
+// Each kernel declares the uniforms it uses, at these locations:
+// 0: number of elements, 1: element offset of the input, 2: element offset of the output, 3 and up: kernel specific.
+
+constexpr const char *scan_source = R"glsl(
+layout(std430, binding = 0) readonly buffer Input { INPUT_T data_in[]; };
+layout(std430, binding = 1) buffer Output { T data_out[]; };
+layout(std430, binding = 2) writeonly buffer BlockSums { T block_sums[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 1) uniform uint u_in_offset;
+layout(location = 2) uniform uint u_out_offset;
+layout(location = 3) uniform uint u_write_sums;
+
+const uint WG = gl_WorkGroupSize.x;
+shared T s_sums[WG];
+
+void main()
+{
+    const uint lid = gl_LocalInvocationID.x;
+    const uint first = (gl_WorkGroupID.x * WG + lid) * ITEMS;
+
+    T values[ITEMS];
+    T total = T(0);
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = first + i;
+        const T value = index < u_count ? LOAD(data_in[u_in_offset + index]) : T(0);
+#if INCLUSIVE
+        total += value;
+        values[i] = total;
+#else
+        values[i] = total;
+        total += value;
+#endif
+    }
+
+    // Hillis-Steele scan of the per-invocation totals
+    s_sums[lid] = total;
+    barrier();
+    for (uint d = 1u; d < WG; d <<= 1u)
+    {
+        const T other = lid >= d ? s_sums[lid - d] : T(0);
+        barrier();
+        s_sums[lid] += other;
+        barrier();
+    }
+
+    const T prefix = lid > 0u ? s_sums[lid - 1u] : T(0);
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = first + i;
+        if (index < u_count)
+            data_out[u_out_offset + index] = prefix + values[i];
+    }
+
+    if (u_write_sums != 0u && lid == WG - 1u)
+        block_sums[gl_WorkGroupID.x] = s_sums[lid];
+}
+)glsl";
+
+constexpr const char *scan_add_source = R"glsl(
+layout(std430, binding = 1) buffer Output { T data_out[]; };
+layout(std430, binding = 2) readonly buffer BlockSums { T block_sums[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 2) uniform uint u_out_offset;
+
+const uint WG = gl_WorkGroupSize.x;
+
+void main()
+{
+    const uint first = (gl_WorkGroupID.x * WG + gl_LocalInvocationID.x) * ITEMS;
+    const T sum = block_sums[gl_WorkGroupID.x];
+
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = first + i;
+        if (index < u_count)
+            data_out[u_out_offset + index] += sum;
+    }
+}
+)glsl";
+
+constexpr const char *reduce_source = R"glsl(
+layout(std430, binding = 0) readonly buffer Input { T data_in[]; };
+layout(std430, binding = 1) writeonly buffer Output { T data_out[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 1) uniform uint u_in_offset;
+layout(location = 2) uniform uint u_out_offset;
+
+const uint WG = gl_WorkGroupSize.x;
+shared T s_values[WG];
+
+void main()
+{
+    const uint lid = gl_LocalInvocationID.x;
+    const uint first = gl_WorkGroupID.x * WG * ITEMS + lid;
+
+    T value = IDENTITY;
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = first + i * WG;
+        if (index < u_count)
+            value = OP(value, data_in[u_in_offset + index]);
+    }
+
+    s_values[lid] = value;
+    barrier();
+    for (uint s = WG / 2u; s > 0u; s >>= 1u)
+    {
+        if (lid < s)
+            s_values[lid] = OP(s_values[lid], s_values[lid + s]);
+        barrier();
+    }
+
+    if (lid == 0u)
+        data_out[u_out_offset + gl_WorkGroupID.x] = s_values[0];
+}
+)glsl";
+
+constexpr const char *radix_histogram_source = R"glsl(
+layout(std430, binding = 0) readonly buffer Keys { uint keys[]; };
+layout(std430, binding = 2) writeonly buffer Histogram { uint histogram[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 1) uniform uint u_in_offset;
+layout(location = 3) uniform uint u_shift;
+
+const uint WG = gl_WorkGroupSize.x;
+shared uint s_bins[BINS];
+
+void main()
+{
+    const uint lid = gl_LocalInvocationID.x;
+
+    if (lid < BINS)
+        s_bins[lid] = 0u;
+    barrier();
+
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = (gl_WorkGroupID.x * ITEMS + i) * WG + lid;
+        if (index < u_count)
+            atomicAdd(s_bins[(keys[u_in_offset + index] >> u_shift) & (BINS - 1u)], 1u);
+    }
+    barrier();
+
+    // digit-major, so that an exclusive scan yields the output offset of each digit of each work group
+    if (lid < BINS)
+        histogram[lid * gl_NumWorkGroups.x + gl_WorkGroupID.x] = s_bins[lid];
+}
+)glsl";
+
+constexpr const char *radix_scatter_source = R"glsl(
+layout(std430, binding = 0) readonly buffer KeysIn { uint keys_in[]; };
+layout(std430, binding = 1) writeonly buffer KeysOut { uint keys_out[]; };
+layout(std430, binding = 2) readonly buffer Offsets { uint offsets[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 1) uniform uint u_in_offset;
+layout(location = 2) uniform uint u_out_offset;
+layout(location = 3) uniform uint u_shift;
+
+#if VALUES
+layout(std430, binding = 3) readonly buffer ValuesIn { uint values_in[]; };
+layout(std430, binding = 4) writeonly buffer ValuesOut { uint values_out[]; };
+
+layout(location = 4) uniform uint u_values_in_offset;
+layout(location = 5) uniform uint u_values_out_offset;
+#endif
+
+const uint WG = gl_WorkGroupSize.x;
+
+// per-invocation counts of the 16 digits, as 16-bit fields packed into two uvec4
+shared uvec4 s_counts[2u * WG];
+shared uint s_offsets[BINS];
+
+void main()
+{
+    const uint lid = gl_LocalInvocationID.x;
+
+    if (lid < BINS)
+        s_offsets[lid] = offsets[lid * gl_NumWorkGroups.x + gl_WorkGroupID.x];
+
+    // rounds are processed in order, so equal keys keep their order
+    for (uint round = 0u; round < ITEMS; round++)
+    {
+        const uint index = (gl_WorkGroupID.x * ITEMS + round) * WG + lid;
+        const bool valid = index < u_count;
+        const uint key = valid ? keys_in[u_in_offset + index] : 0u;
+        const uint digit = (key >> u_shift) & (BINS - 1u);
+        const uint word = digit >> 1u;
+        const uint shift = (digit & 1u) * 16u;
+
+        uvec4 lo = uvec4(0u);
+        uvec4 hi = uvec4(0u);
+        if (valid)
+        {
+            if (word < 4u)
+                lo[word] = 1u << shift;
+            else
+                hi[word - 4u] = 1u << shift;
+        }
+
+        barrier();
+        s_counts[2u * lid] = lo;
+        s_counts[2u * lid + 1u] = hi;
+        barrier();
+        for (uint d = 1u; d < WG; d <<= 1u)
+        {
+            if (lid >= d)
+            {
+                lo += s_counts[2u * (lid - d)];
+                hi += s_counts[2u * (lid - d) + 1u];
+            }
+            barrier();
+            s_counts[2u * lid] = lo;
+            s_counts[2u * lid + 1u] = hi;
+            barrier();
+        }
+
+        if (valid)
+        {
+            const uint counts = word < 4u ? lo[word] : hi[word - 4u];
+            const uint dest = s_offsets[digit] + ((counts >> shift) & 0xFFFFu) - 1u;
+            keys_out[u_out_offset + dest] = key;
+#if VALUES
+            values_out[u_values_out_offset + dest] = values_in[u_values_in_offset + index];
+#endif
+        }
+        barrier();
+
+        if (lid < BINS)
+        {
+            const uint total_word = lid >> 1u;
+            const uvec4 totals = s_counts[2u * (WG - 1u) + (total_word >> 2u)];
+            s_offsets[lid] += (totals[total_word & 3u] >> ((lid & 1u) * 16u)) & 0xFFFFu;
+        }
+    }
+}
+)glsl";
+
+constexpr const char *compact_scatter_source = R"glsl(
+layout(std430, binding = 0) readonly buffer Input { uint data_in[]; };
+layout(std430, binding = 1) writeonly buffer Output { uint data_out[]; };
+layout(std430, binding = 2) readonly buffer Flags { uint flags[]; };
+layout(std430, binding = 3) readonly buffer Indices { uint indices[]; };
+layout(std430, binding = 4) writeonly buffer Count { uint count_out[]; };
+
+layout(location = 0) uniform uint u_count;
+layout(location = 1) uniform uint u_in_offset;
+layout(location = 2) uniform uint u_out_offset;
+layout(location = 3) uniform uint u_flags_offset;
+layout(location = 4) uniform uint u_count_offset;
+
+const uint WG = gl_WorkGroupSize.x;
+
+void main()
+{
+    const uint first = (gl_WorkGroupID.x * WG + gl_LocalInvocationID.x) * ITEMS;
+
+    for (uint i = 0u; i < ITEMS; i++)
+    {
+        const uint index = first + i;
+        if (index >= u_count)
+            break;
+
+        const bool keep = flags[u_flags_offset + index] != 0u;
+        if (keep)
+            data_out[u_out_offset + indices[index]] = data_in[u_in_offset + index];
+
+        if (index == u_count - 1u)
+            count_out[u_count_offset] = indices[index] + uint(keep);
+    }
+}
+)glsl";
+
+auto getTypeName(GpuPrimitives::ValueType type) -> const char *
+{
+    switch (type)
+    {
+        case GpuPrimitives::ValueType::int32:
+            return "int";
+        case GpuPrimitives::ValueType::float32:
+            return "float";
+        default:
+            return "uint";
+    }
+}
+
+auto getIdentity(GpuPrimitives::ReduceOp op, GpuPrimitives::ValueType type) -> const char *
+{
+    using ValueType = GpuPrimitives::ValueType;
+
+    switch (op)
+    {
+        case GpuPrimitives::ReduceOp::min:
+            return type == ValueType::uint32 ? "0xFFFFFFFFu"
+                                             : type == ValueType::int32 ? "0x7FFFFFFF"
+                                                                        : "uintBitsToFloat(0x7F800000u)";
+        case GpuPrimitives::ReduceOp::max:
+            return type == ValueType::uint32 ? "0u"
+                                             : type == ValueType::int32 ? "(-0x7FFFFFFF - 1)"
+                                                                        : "(-uintBitsToFloat(0x7F800000u))";
+        default:
+            return "T(0)";
+    }
+}
+
+auto getOp(GpuPrimitives::ReduceOp op) -> const char *
+{
+    switch (op)
+    {
+        case GpuPrimitives::ReduceOp::min:
+            return "min(a, b)";
+        case GpuPrimitives::ReduceOp::max:
+            return "max(a, b)";
+        default:
+            return "((a) + (b))";
+    }
+}
+
+auto toElementOffset(GLintptr offset) -> GLuint
+{
+    if (offset % 4 != 0)
+        throw Error("array offset must be a multiple of four");
+
+    return static_cast<GLuint>(offset / 4);
+}
+
+void bindStorage(GLuint index, BufferHandle buffer)
+{
+    buffer.bindBase(BufferHandle::IndexedTarget::shader_storage, index);
+}
+
+void storageBarrier()
+{
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+} // namespace
+
+GpuPrimitives::GpuPrimitives(GLuint work_group_size)
+        : m_work_group_size(work_group_size)
+{
+    if (work_group_size < 16 || (work_group_size & (work_group_size - 1)) != 0)
+        throw Error("work group size must be a power of two of at least 16");
+
+    const auto &limits = getLimits();
+    if (work_group_size > GLuint(limits.max_compute_work_group_invocations)
+        || work_group_size > GLuint(limits.max_compute_work_group_size[0]))
+        throw Error("work group size " + std::to_string(work_group_size) + " exceeds the compute limits");
+
+    // the radix scatter kernel needs the most: two uvec4 of digit counts per invocation and the 16 digit offsets
+    const auto shared_size = std::size_t(work_group_size) * 2 * 16 + 16 * 4;
+    if (shared_size > std::size_t(limits.max_compute_shared_memory_size))
+        throw Error("work group size " + std::to_string(work_group_size) + " needs " + std::to_string(shared_size)
+                    + " bytes of shared memory, more than GL_MAX_COMPUTE_SHARED_MEMORY_SIZE");
+}
+
+void GpuPrimitives::exclusiveScan(Array input, Array output, GLuint count, ValueType type)
+{
+    if (count > 0)
+        scan(input, output, count, type, false, false, 0);
+}
+
+void GpuPrimitives::inclusiveScan(Array input, Array output, GLuint count, ValueType type)
+{
+    if (count > 0)
+        scan(input, output, count, type, true, false, 0);
+}
+
+void GpuPrimitives::reduce(Array input, Array output, GLuint count, ReduceOp op, ValueType type)
+{
+    const auto program = getProgram(Kernel::reduce, type, static_cast<GLuint>(op));
+    program.use();
+
+    Array source = input;
+    std::size_t pass = 0;
+
+    while (true)
+    {
+        const auto groups = std::max(getGroupCount(count), GLuint(1));
+        const Array target = groups == 1
+                             ? output
+                             : Array{getScratch(m_reduce[pass % 2], GLsizeiptr(groups) * 4), 0};
+
+        program.setUniform(0, count);
+        program.setUniform(1, toElementOffset(source.offset));
+        program.setUniform(2, toElementOffset(target.offset));
+        bindStorage(0, source.buffer);
+        bindStorage(1, target.buffer);
+        ProgramHandle::dispatchCompute(groups);
+
+        if (groups == 1)
+            break;
+
+        storageBarrier();
+        source = target;
+        count = groups;
+        pass++;
+    }
+}
+
+void GpuPrimitives::sort(Array keys, GLuint count, GLuint key_bits)
+{
+    radixSort(keys, nullptr, count, key_bits);
+}
+
+void GpuPrimitives::sortKeyValue(Array keys, Array values, GLuint count, GLuint key_bits)
+{
+    radixSort(keys, &values, count, key_bits);
+}
+
+void GpuPrimitives::compact(Array input, Array flags, Array output, Array output_count, GLuint count)
+{
+    if (count == 0)
+    {
+        glClearNamedBufferSubData(output_count.buffer.getName(), GL_R32UI, output_count.offset, 4, GL_RED_INTEGER,
+                                  GL_UNSIGNED_INT, nullptr);
+        return;
+    }
+
+    const auto indices = getScratch(m_indices, GLsizeiptr(count) * 4);
+    scan(flags, {indices, 0}, count, ValueType::uint32, false, true, 0);
+    storageBarrier();
+
+    const auto program = getProgram(Kernel::compact_scatter, ValueType::uint32);
+    program.setUniform(0, count);
+    program.setUniform(1, toElementOffset(input.offset));
+    program.setUniform(2, toElementOffset(output.offset));
+    program.setUniform(3, toElementOffset(flags.offset));
+    program.setUniform(4, toElementOffset(output_count.offset));
+    bindStorage(0, input.buffer);
+    bindStorage(1, output.buffer);
+    bindStorage(2, flags.buffer);
+    bindStorage(3, indices);
+    bindStorage(4, output_count.buffer);
+    program.use();
+    ProgramHandle::dispatchCompute(getGroupCount(count));
+}
+
+void GpuPrimitives::clear()
+{
+    m_programs.clear();
+    m_scan_sums.clear();
+    for (auto scratch: {&m_reduce[0], &m_reduce[1], &m_histogram, &m_keys, &m_values, &m_indices})
+    {
+        scratch->buffer = BufferHandle{};
+        scratch->size = 0;
+    }
+}
+
+auto GpuPrimitives::getProgram(Kernel kernel, ValueType type, GLuint variant) -> ProgramHandle
+{
+    const auto key = std::uint64_t(kernel) << 32 | std::uint64_t(type) << 16 | variant;
+
+    const auto iter = m_programs.find(key);
+    if (iter != m_programs.end())
+        return iter->second;
+
+    std::string source = "#version 450\n";
+    source += "layout(local_size_x = " + std::to_string(m_work_group_size) + ") in;\n";
+    source += "#define ITEMS " + std::to_string(s_items_per_invocation) + "u\n";
+    source += "#define BINS " + std::to_string(1u << radix_bits) + "u\n";
+    source += std::string("#define T ") + getTypeName(type) + "\n";
+
+    switch (kernel)
+    {
+        case Kernel::scan:
+        {
+            // variant: bit 0 inclusive, bit 1 scan (flag != 0) instead of the values
+            const bool predicate = variant & 2;
+            source += std::string("#define INCLUSIVE ") + (variant & 1 ? "1" : "0") + "\n";
+            source += predicate ? "#define INPUT_T uint\n#define LOAD(x) uint((x) != 0u)\n"
+                                : "#define INPUT_T T\n#define LOAD(x) (x)\n";
+            source += scan_source;
+            break;
+        }
+        case Kernel::scan_add:
+            source += scan_add_source;
+            break;
+        case Kernel::reduce:
+        {
+            const auto op = static_cast<ReduceOp>(variant);
+            source += std::string("#define IDENTITY ") + getIdentity(op, type) + "\n";
+            source += std::string("#define OP(a, b) ") + getOp(op) + "\n";
+            source += reduce_source;
+            break;
+        }
+        case Kernel::radix_histogram:
+            source += radix_histogram_source;
+            break;
+        case Kernel::radix_scatter:
+            source += std::string("#define VALUES ") + (variant ? "1" : "0") + "\n";
+            source += radix_scatter_source;
+            break;
+        case Kernel::compact_scatter:
+            source += compact_scatter_source;
+            break;
+    }
+
+    Program program{ProgramHandle::createSeparable(ShaderHandle::Type::compute, source)};
+    if (program.getParameter(ProgramHandle::Parameter::link_status) != GL_TRUE)
+        throw Error("failed to build GPU primitive kernel: " + program.getInfoLog());
+
+    return m_programs.emplace(key, std::move(program)).first->second;
+}
+
+auto GpuPrimitives::getScratch(Scratch &scratch, GLsizeiptr size) -> BufferHandle
+{
+    if (scratch.size < size)
+    {
+        scratch.buffer = BufferHandle::create();
+        scratch.buffer.allocateImmutable(size, BufferHandle::StorageFlags::none);
+        scratch.size = size;
+    }
+
+    return scratch.buffer;
+}
+
+auto GpuPrimitives::getGroupCount(GLuint count) const -> GLuint
+{
+    const auto groups = ProgramHandle::getGroupCount({count, 1, 1}, {GLint(getBlockSize()), 1, 1})[0];
+
+    if (groups > GLuint(getLimits().max_compute_work_group_count[0]))
+        throw Error("too many elements for a GPU primitive: " + std::to_string(count));
+
+    return groups;
+}
+
+void GpuPrimitives::scan(Array input, Array output, GLuint count, ValueType type, bool inclusive, bool predicate,
+                         std::size_t level)
+{
+    const auto groups = getGroupCount(count);
+
+    if (m_scan_sums.size() <= level)
+        m_scan_sums.resize(level + 1);
+    const auto sums = getScratch(m_scan_sums[level], GLsizeiptr(groups) * 4);
+
+    const auto program = getProgram(Kernel::scan, type, GLuint(inclusive) | GLuint(predicate) << 1);
+    program.setUniform(0, count);
+    program.setUniform(1, toElementOffset(input.offset));
+    program.setUniform(2, toElementOffset(output.offset));
+    program.setUniform(3, GLuint(groups > 1));
+    bindStorage(0, input.buffer);
+    bindStorage(1, output.buffer);
+    bindStorage(2, sums);
+    program.use();
+    ProgramHandle::dispatchCompute(groups);
+
+    if (groups == 1)
+        return;
+
+    // scan the sums of the blocks, then add them to the elements of the following blocks
+    storageBarrier();
+    scan({sums, 0}, {sums, 0}, groups, type, false, false, level + 1);
+    storageBarrier();
+
+    const auto add = getProgram(Kernel::scan_add, type);
+    add.setUniform(0, count);
+    add.setUniform(2, toElementOffset(output.offset));
+    bindStorage(1, output.buffer);
+    bindStorage(2, sums);
+    add.use();
+    ProgramHandle::dispatchCompute(groups);
+}
+
+void GpuPrimitives::radixSort(Array keys, const Array *values, GLuint count, GLuint key_bits)
+{
+    const auto passes = (std::min(key_bits, GLuint(32)) + radix_bits - 1) / radix_bits;
+    if (count == 0 || passes == 0)
+        return;
+
+    const auto groups = getGroupCount(count);
+    const GLuint bins = 1u << radix_bits;
+    const auto histogram = getScratch(m_histogram, GLsizeiptr(bins) * groups * 4);
+
+    Array keys_in = keys;
+    Array keys_out{getScratch(m_keys, GLsizeiptr(count) * 4), 0};
+    Array values_in = values ? *values : Array{};
+    Array values_out = values ? Array{getScratch(m_values, GLsizeiptr(count) * 4), 0} : Array{};
+
+    const auto count_histogram = getProgram(Kernel::radix_histogram, ValueType::uint32);
+    const auto scatter = getProgram(Kernel::radix_scatter, ValueType::uint32, values ? 1 : 0);
+
+    for (GLuint pass = 0; pass < passes; pass++)
+    {
+        const auto shift = pass * radix_bits;
+
+        if (pass > 0)
+            storageBarrier();
+
+        count_histogram.setUniform(0, count);
+        count_histogram.setUniform(1, toElementOffset(keys_in.offset));
+        count_histogram.setUniform(3, shift);
+        bindStorage(0, keys_in.buffer);
+        bindStorage(2, histogram);
+        count_histogram.use();
+        ProgramHandle::dispatchCompute(groups);
+
+        storageBarrier();
+        scan({histogram, 0}, {histogram, 0}, bins * groups, ValueType::uint32, false, false, 0);
+        storageBarrier();
+
+        scatter.setUniform(0, count);
+        scatter.setUniform(1, toElementOffset(keys_in.offset));
+        scatter.setUniform(2, toElementOffset(keys_out.offset));
+        scatter.setUniform(3, shift);
+        bindStorage(0, keys_in.buffer);
+        bindStorage(1, keys_out.buffer);
+        bindStorage(2, histogram);
+        if (values)
+        {
+            scatter.setUniform(4, toElementOffset(values_in.offset));
+            scatter.setUniform(5, toElementOffset(values_out.offset));
+            bindStorage(3, values_in.buffer);
+            bindStorage(4, values_out.buffer);
+        }
+        scatter.use();
+        ProgramHandle::dispatchCompute(groups);
+
+        std::swap(keys_in, keys_out);
+        std::swap(values_in, values_out);
+    }
+
+    // after an odd number of passes the result is in the temporary arrays
+    if (passes % 2 == 1)
+    {
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+        BufferHandle::copy(keys_in.buffer, keys.buffer, 0, keys.offset, GLsizeiptr(count) * 4);
+        if (values)
+            BufferHandle::copy(values_in.buffer, values->buffer, 0, values->offset, GLsizeiptr(count) * 4);
+    }
+}
+
+} // GL
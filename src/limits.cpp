@@ -0,0 +1,108 @@
+#include "glutils/limits.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+
+namespace GL {
+
+namespace {
+
+auto getInteger(GLenum pname) -> GLint
+{
+    GLint value = 0;
+    glGetIntegerv(pname, &value);
+    return value;
+}
+
+auto getInteger64(GLenum pname) -> GLint64
+{
+    GLint64 value = 0;
+    glGetInteger64v(pname, &value);
+    return value;
+}
+
+auto getFloat(GLenum pname) -> GLfloat
+{
+    GLfloat value = 0.0f;
+    glGetFloatv(pname, &value);
+    return value;
+}
+
+auto getIntegers3(GLenum pname) -> std::array<GLint, 3>
+{
+    std::array<GLint, 3> values{};
+    for (GLuint i = 0; i < values.size(); i++)
+        glGetIntegeri_v(pname, i, &values[i]);
+    return values;
+}
+
+auto getString(GLenum name) -> std::string
+{
+    const auto string = reinterpret_cast<const char *>(glGetString(name));
+    return string ? string : "";
+}
+
+} // namespace
+
+bool Limits::hasExtension(std::string_view name) const
+{
+    return std::binary_search(extensions.begin(), extensions.end(), name);
+}
+
+auto queryLimits() -> Limits
+{
+    Limits limits;
+
+    limits.max_uniform_buffer_bindings = getInteger(GL_MAX_UNIFORM_BUFFER_BINDINGS);
+    limits.max_shader_storage_buffer_bindings = getInteger(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS);
+    limits.max_atomic_counter_buffer_bindings = getInteger(GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS);
+    limits.max_transform_feedback_buffers = getInteger(GL_MAX_TRANSFORM_FEEDBACK_BUFFERS);
+
+    limits.uniform_buffer_offset_alignment = getInteger(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+    limits.shader_storage_buffer_offset_alignment = getInteger(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT);
+    limits.min_map_buffer_alignment = getInteger(GL_MIN_MAP_BUFFER_ALIGNMENT);
+
+    limits.max_uniform_block_size = getInteger64(GL_MAX_UNIFORM_BLOCK_SIZE);
+    limits.max_shader_storage_block_size = getInteger64(GL_MAX_SHADER_STORAGE_BLOCK_SIZE);
+
+    limits.max_texture_size = getInteger(GL_MAX_TEXTURE_SIZE);
+    limits.max_3d_texture_size = getInteger(GL_MAX_3D_TEXTURE_SIZE);
+    limits.max_cube_map_texture_size = getInteger(GL_MAX_CUBE_MAP_TEXTURE_SIZE);
+    limits.max_array_texture_layers = getInteger(GL_MAX_ARRAY_TEXTURE_LAYERS);
+    limits.max_texture_buffer_size = getInteger(GL_MAX_TEXTURE_BUFFER_SIZE);
+    limits.max_texture_image_units = getInteger(GL_MAX_TEXTURE_IMAGE_UNITS);
+    limits.max_combined_texture_image_units = getInteger(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
+    limits.max_image_units = getInteger(GL_MAX_IMAGE_UNITS);
+    limits.max_texture_max_anisotropy = getFloat(GL_MAX_TEXTURE_MAX_ANISOTROPY);
+    limits.max_texture_lod_bias = getFloat(GL_MAX_TEXTURE_LOD_BIAS);
+
+    limits.max_vertex_attribs = getInteger(GL_MAX_VERTEX_ATTRIBS);
+    limits.max_vertex_attrib_bindings = getInteger(GL_MAX_VERTEX_ATTRIB_BINDINGS);
+
+    limits.max_color_attachments = getInteger(GL_MAX_COLOR_ATTACHMENTS);
+    limits.max_draw_buffers = getInteger(GL_MAX_DRAW_BUFFERS);
+    limits.max_samples = getInteger(GL_MAX_SAMPLES);
+
+    limits.max_compute_work_group_count = getIntegers3(GL_MAX_COMPUTE_WORK_GROUP_COUNT);
+    limits.max_compute_work_group_size = getIntegers3(GL_MAX_COMPUTE_WORK_GROUP_SIZE);
+    limits.max_compute_work_group_invocations = getInteger(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS);
+    limits.max_compute_shared_memory_size = getInteger(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE);
+
+    limits.num_program_binary_formats = getInteger(GL_NUM_PROGRAM_BINARY_FORMATS);
+    limits.num_shader_binary_formats = getInteger(GL_NUM_SHADER_BINARY_FORMATS);
+
+    limits.vendor = getString(GL_VENDOR);
+    limits.renderer = getString(GL_RENDERER);
+    limits.version = getString(GL_VERSION);
+    limits.shading_language_version = getString(GL_SHADING_LANGUAGE_VERSION);
+
+    const auto extension_count = getInteger(GL_NUM_EXTENSIONS);
+    limits.extensions.reserve(extension_count);
+    for (GLint i = 0; i < extension_count; i++)
+        limits.extensions.emplace_back(reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)));
+    std::sort(limits.extensions.begin(), limits.extensions.end());
+
+    return limits;
+}
+
+} // GL
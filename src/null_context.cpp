@@ -0,0 +1,683 @@
+#include "glutils/null_context.hpp"
+#include "glutils/error.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace GL::Null {
+
+namespace {
+
+// Functions which need more than a call counter. Each one gets a fixed slot at the start of the counter table.
+#define GLUTILS_NULL_SPECIAL_PROCS(X) \
+    X(GetString)                      \
+    X(GetStringi)                     \
+    X(GetIntegerv)                    \
+    X(GetInteger64v)                  \
+    X(GetIntegeri_v)                  \
+    X(GetFloatv)                      \
+    X(GetError)                       \
+    X(CreateBuffers)                  \
+    X(DeleteBuffers)                  \
+    X(CreateTextures)                 \
+    X(DeleteTextures)                 \
+    X(CreateVertexArrays)             \
+    X(DeleteVertexArrays)             \
+    X(CreateProgramPipelines)         \
+    X(DeleteProgramPipelines)         \
+    X(CreateTransformFeedbacks)       \
+    X(DeleteTransformFeedbacks)       \
+    X(CreateSamplers)                 \
+    X(DeleteSamplers)                 \
+    X(CreateProgram)                  \
+    X(CreateShaderProgramv)           \
+    X(DeleteProgram)                  \
+    X(CreateShader)                   \
+    X(DeleteShader)                   \
+    X(GetProgramiv)                   \
+    X(GetShaderiv)                    \
+    X(GetProgramInfoLog)              \
+    X(GetProgramBinary)               \
+    X(GetShaderInfoLog)               \
+    X(GetProgramInterfaceiv)          \
+    X(GetProgramResourceiv)           \
+    X(GetProgramResourceLocation)     \
+    X(GetProgramResourceIndex)        \
+    X(GetProgramResourceLocationIndex)\
+    X(NamedBufferData)                \
+    X(NamedBufferStorage)             \
+    X(GetNamedBufferParameteriv)      \
+    X(GetNamedBufferParameteri64v)    \
+    X(MapNamedBuffer)                 \
+    X(MapNamedBufferRange)            \
+    X(UnmapNamedBuffer)               \
+    X(FenceSync)                      \
+    X(ClientWaitSync)
+
+enum SpecialProc : std::size_t
+{
+#define GLUTILS_NULL_SPECIAL_ENUM(NAME) s_##NAME,
+    GLUTILS_NULL_SPECIAL_PROCS(GLUTILS_NULL_SPECIAL_ENUM)
+#undef GLUTILS_NULL_SPECIAL_ENUM
+    special_proc_count
+};
+
+// Every function glad loads, listed from its header at configure time. GLUTILS_NULL_PROCS(X) expands X(NAME) for each.
+#include "null_context_procs.inl"
+
+// Functions which only count their calls. Each one gets a slot after the special ones in the counter table.
+enum CountingProc : std::size_t
+{
+#define GLUTILS_NULL_COUNTING_ENUM(NAME) c_##NAME,
+    GLUTILS_NULL_PROCS(GLUTILS_NULL_COUNTING_ENUM)
+#undef GLUTILS_NULL_COUNTING_ENUM
+    counting_proc_count
+};
+
+constexpr std::size_t proc_count = special_proc_count + counting_proc_count;
+
+std::array<std::size_t, proc_count> g_call_counts{};
+
+bool g_validate = false;
+
+GLuint g_next_name = 1;
+std::uintptr_t g_next_sync = 1;
+
+struct BufferState
+{
+    std::vector<unsigned char> storage;
+    bool immutable{false};
+};
+
+std::unordered_map<GLuint, BufferState> g_buffers;
+std::unordered_set<GLuint> g_textures;
+std::unordered_set<GLuint> g_vertex_arrays;
+std::unordered_set<GLuint> g_program_pipelines;
+std::unordered_set<GLuint> g_transform_feedbacks;
+std::unordered_set<GLuint> g_samplers;
+std::unordered_set<GLuint> g_programs;
+std::unordered_set<GLuint> g_shaders;
+
+constexpr const char *g_extensions[]{"GL_KHR_debug"};
+
+template<std::size_t I, typename Function>
+struct CountingStub;
+
+// Counts the calls of function I, and returns zero or nullptr, with the signature glad calls it with.
+template<std::size_t I, typename Ret, typename... Args>
+struct CountingStub<I, Ret (GLAD_API_PTR *)(Args...)>
+{
+    static auto GLAD_API_PTR call(Args...) -> Ret
+    {
+        ++g_call_counts[I];
+        if constexpr (!std::is_void_v<Ret>)
+            return Ret{};
+    }
+};
+
+template<class Container>
+void validateName(const Container &objects, GLuint name, const char *function)
+{
+    if (g_validate && name != 0 && objects.find(name) == objects.end())
+        throw Error(std::string(function) + ": " + std::to_string(name) + " is not the name of a live object");
+}
+
+template<class Container>
+void createNames(Container &objects, GLsizei n, GLuint *names)
+{
+    for (GLsizei i = 0; i < n; i++)
+    {
+        names[i] = g_next_name++;
+        objects.emplace(names[i]);
+    }
+}
+
+template<class Container>
+void deleteNames(Container &objects, GLsizei n, const GLuint *names, const char *function)
+{
+    for (GLsizei i = 0; i < n; i++)
+    {
+        validateName(objects, names[i], function);
+        objects.erase(names[i]);
+    }
+}
+
+auto getBuffer(GLuint buffer, const char *function) -> BufferState &
+{
+    validateName(g_buffers, buffer, function);
+    return g_buffers[buffer];
+}
+
+auto GLAD_API_PTR nullGetString(GLenum name) -> const GLubyte *
+{
+    ++g_call_counts[s_GetString];
+
+    const char *string;
+    switch (name)
+    {
+        case GL_VENDOR:
+            string = "glutils";
+            break;
+        case GL_RENDERER:
+            string = "null";
+            break;
+        case GL_VERSION:
+            string = "4.6.0 glutils null context";
+            break;
+        case GL_SHADING_LANGUAGE_VERSION:
+            string = "4.60";
+            break;
+        default:
+            string = nullptr;
+    }
+
+    return reinterpret_cast<const GLubyte *>(string);
+}
+
+auto GLAD_API_PTR nullGetStringi(GLenum name, GLuint index) -> const GLubyte *
+{
+    ++g_call_counts[s_GetStringi];
+
+    if (name != GL_EXTENSIONS || index >= std::size(g_extensions))
+        return nullptr;
+
+    return reinterpret_cast<const GLubyte *>(g_extensions[index]);
+}
+
+auto getInteger(GLenum pname) -> GLint64
+{
+    switch (pname)
+    {
+        case GL_MAJOR_VERSION:
+            return 4;
+        case GL_MINOR_VERSION:
+            return 6;
+        case GL_NUM_EXTENSIONS:
+            return std::size(g_extensions);
+        case GL_CONTEXT_FLAGS:
+            return GL_CONTEXT_FLAG_DEBUG_BIT;
+
+        // the minimum maximums required by the OpenGL 4.6 specification
+        case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+            return 84;
+        case GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS:
+        case GL_MAX_IMAGE_UNITS:
+            return 8;
+        case GL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS:
+        case GL_MAX_TRANSFORM_FEEDBACK_BUFFERS:
+            return 4;
+        case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+        case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT:
+            return 256;
+        case GL_MIN_MAP_BUFFER_ALIGNMENT:
+            return 64;
+        case GL_MAX_UNIFORM_BLOCK_SIZE:
+            return 16384;
+        case GL_MAX_SHADER_STORAGE_BLOCK_SIZE:
+            return 1 << 27;
+        case GL_MAX_TEXTURE_SIZE:
+        case GL_MAX_3D_TEXTURE_SIZE:
+        case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+        case GL_MAX_ARRAY_TEXTURE_LAYERS:
+            return 2048;
+        case GL_MAX_TEXTURE_BUFFER_SIZE:
+            return 65536;
+        case GL_MAX_TEXTURE_IMAGE_UNITS:
+        case GL_MAX_VERTEX_ATTRIBS:
+        case GL_MAX_VERTEX_ATTRIB_BINDINGS:
+            return 16;
+        case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+            return 80;
+        case GL_MAX_COLOR_ATTACHMENTS:
+        case GL_MAX_DRAW_BUFFERS:
+            return 8;
+        case GL_MAX_SAMPLES:
+            return 4;
+        case GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS:
+            return 1024;
+        case GL_MAX_COMPUTE_SHARED_MEMORY_SIZE:
+            return 32768;
+
+        // initial pixel store state
+        case GL_PACK_ALIGNMENT:
+        case GL_UNPACK_ALIGNMENT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+void GLAD_API_PTR nullGetIntegerv(GLenum pname, GLint *data)
+{
+    ++g_call_counts[s_GetIntegerv];
+    *data = static_cast<GLint>(getInteger(pname));
+}
+
+void GLAD_API_PTR nullGetInteger64v(GLenum pname, GLint64 *data)
+{
+    ++g_call_counts[s_GetInteger64v];
+    *data = getInteger(pname);
+}
+
+void GLAD_API_PTR nullGetIntegeri_v(GLenum target, GLuint index, GLint *data)
+{
+    ++g_call_counts[s_GetIntegeri_v];
+
+    switch (target)
+    {
+        case GL_MAX_COMPUTE_WORK_GROUP_COUNT:
+            *data = 65535;
+            break;
+        case GL_MAX_COMPUTE_WORK_GROUP_SIZE:
+            *data = index < 2 ? 1024 : 64;
+            break;
+        default:
+            *data = 0;
+    }
+}
+
+void GLAD_API_PTR nullGetFloatv(GLenum pname, GLfloat *data)
+{
+    ++g_call_counts[s_GetFloatv];
+
+    switch (pname)
+    {
+        case GL_MAX_TEXTURE_MAX_ANISOTROPY:
+            *data = 16.0f;
+            break;
+        case GL_MAX_TEXTURE_LOD_BIAS:
+            *data = 2.0f;
+            break;
+        default:
+            *data = static_cast<GLfloat>(getInteger(pname));
+    }
+}
+
+auto GLAD_API_PTR nullGetError() -> GLenum
+{
+    ++g_call_counts[s_GetError];
+    return GL_NO_ERROR;
+}
+
+void GLAD_API_PTR nullCreateBuffers(GLsizei n, GLuint *buffers)
+{
+    ++g_call_counts[s_CreateBuffers];
+
+    for (GLsizei i = 0; i < n; i++)
+    {
+        buffers[i] = g_next_name++;
+        g_buffers.emplace(buffers[i], BufferState());
+    }
+}
+
+void GLAD_API_PTR nullDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    ++g_call_counts[s_DeleteBuffers];
+    deleteNames(g_buffers, n, buffers, "glDeleteBuffers");
+}
+
+void GLAD_API_PTR nullCreateTextures(GLenum, GLsizei n, GLuint *textures)
+{
+    ++g_call_counts[s_CreateTextures];
+    createNames(g_textures, n, textures);
+}
+
+void GLAD_API_PTR nullDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    ++g_call_counts[s_DeleteTextures];
+    deleteNames(g_textures, n, textures, "glDeleteTextures");
+}
+
+void GLAD_API_PTR nullCreateVertexArrays(GLsizei n, GLuint *arrays)
+{
+    ++g_call_counts[s_CreateVertexArrays];
+    createNames(g_vertex_arrays, n, arrays);
+}
+
+void GLAD_API_PTR nullDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    ++g_call_counts[s_DeleteVertexArrays];
+    deleteNames(g_vertex_arrays, n, arrays, "glDeleteVertexArrays");
+}
+
+void GLAD_API_PTR nullCreateProgramPipelines(GLsizei n, GLuint *pipelines)
+{
+    ++g_call_counts[s_CreateProgramPipelines];
+    createNames(g_program_pipelines, n, pipelines);
+}
+
+void GLAD_API_PTR nullDeleteProgramPipelines(GLsizei n, const GLuint *pipelines)
+{
+    ++g_call_counts[s_DeleteProgramPipelines];
+    deleteNames(g_program_pipelines, n, pipelines, "glDeleteProgramPipelines");
+}
+
+void GLAD_API_PTR nullCreateTransformFeedbacks(GLsizei n, GLuint *ids)
+{
+    ++g_call_counts[s_CreateTransformFeedbacks];
+    createNames(g_transform_feedbacks, n, ids);
+}
+
+void GLAD_API_PTR nullDeleteTransformFeedbacks(GLsizei n, const GLuint *ids)
+{
+    ++g_call_counts[s_DeleteTransformFeedbacks];
+    deleteNames(g_transform_feedbacks, n, ids, "glDeleteTransformFeedbacks");
+}
+
+void GLAD_API_PTR nullCreateSamplers(GLsizei n, GLuint *samplers)
+{
+    ++g_call_counts[s_CreateSamplers];
+    createNames(g_samplers, n, samplers);
+}
+
+void GLAD_API_PTR nullDeleteSamplers(GLsizei n, const GLuint *samplers)
+{
+    ++g_call_counts[s_DeleteSamplers];
+    deleteNames(g_samplers, n, samplers, "glDeleteSamplers");
+}
+
+auto GLAD_API_PTR nullCreateShaderProgramv(GLenum, GLsizei, const GLchar *const *) -> GLuint
+{
+    ++g_call_counts[s_CreateShaderProgramv];
+    GLuint name;
+    createNames(g_programs, 1, &name);
+    return name;
+}
+
+auto GLAD_API_PTR nullCreateProgram() -> GLuint
+{
+    ++g_call_counts[s_CreateProgram];
+    GLuint name;
+    createNames(g_programs, 1, &name);
+    return name;
+}
+
+void GLAD_API_PTR nullDeleteProgram(GLuint program)
+{
+    ++g_call_counts[s_DeleteProgram];
+    deleteNames(g_programs, 1, &program, "glDeleteProgram");
+}
+
+auto GLAD_API_PTR nullCreateShader(GLenum) -> GLuint
+{
+    ++g_call_counts[s_CreateShader];
+    GLuint name;
+    createNames(g_shaders, 1, &name);
+    return name;
+}
+
+void GLAD_API_PTR nullDeleteShader(GLuint shader)
+{
+    ++g_call_counts[s_DeleteShader];
+    deleteNames(g_shaders, 1, &shader, "glDeleteShader");
+}
+
+void GLAD_API_PTR nullGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+    ++g_call_counts[s_GetProgramiv];
+    validateName(g_programs, program, "glGetProgramiv");
+
+    switch (pname)
+    {
+        case GL_LINK_STATUS:
+        case GL_VALIDATE_STATUS:
+            *params = GL_TRUE;
+            break;
+        case GL_PROGRAM_BINARY_LENGTH:
+            *params = sizeof(GLuint);
+            break;
+        case GL_COMPUTE_WORK_GROUP_SIZE:
+            params[0] = params[1] = params[2] = 1;
+            break;
+        default:
+            *params = 0;
+    }
+}
+
+// The binary of a program is its name, so that program binary caches can be exercised.
+void GLAD_API_PTR nullGetProgramBinary(GLuint program, GLsizei buf_size, GLsizei *length, GLenum *binary_format,
+                                       void *binary)
+{
+    ++g_call_counts[s_GetProgramBinary];
+    validateName(g_programs, program, "glGetProgramBinary");
+
+    const GLsizei size = buf_size < GLsizei(sizeof(program)) ? 0 : sizeof(program);
+    std::memcpy(binary, &program, size);
+    if (length)
+        *length = size;
+    *binary_format = 0;
+}
+
+void GLAD_API_PTR nullGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+    ++g_call_counts[s_GetShaderiv];
+    validateName(g_shaders, shader, "glGetShaderiv");
+
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void writeEmptyLog(GLsizei max_length, GLsizei *length, GLchar *info_log)
+{
+    if (length)
+        *length = 0;
+    if (max_length > 0)
+        info_log[0] = '\0';
+}
+
+void GLAD_API_PTR nullGetProgramInfoLog(GLuint program, GLsizei max_length, GLsizei *length, GLchar *info_log)
+{
+    ++g_call_counts[s_GetProgramInfoLog];
+    validateName(g_programs, program, "glGetProgramInfoLog");
+    writeEmptyLog(max_length, length, info_log);
+}
+
+void GLAD_API_PTR nullGetShaderInfoLog(GLuint shader, GLsizei max_length, GLsizei *length, GLchar *info_log)
+{
+    ++g_call_counts[s_GetShaderInfoLog];
+    validateName(g_shaders, shader, "glGetShaderInfoLog");
+    writeEmptyLog(max_length, length, info_log);
+}
+
+void GLAD_API_PTR nullGetProgramInterfaceiv(GLuint program, GLenum, GLenum, GLint *params)
+{
+    ++g_call_counts[s_GetProgramInterfaceiv];
+    validateName(g_programs, program, "glGetProgramInterfaceiv");
+    *params = 0;
+}
+
+void GLAD_API_PTR nullGetProgramResourceiv(GLuint program, GLenum, GLuint, GLsizei, const GLenum *, GLsizei,
+                                           GLsizei *length, GLint *)
+{
+    ++g_call_counts[s_GetProgramResourceiv];
+    validateName(g_programs, program, "glGetProgramResourceiv");
+    if (length)
+        *length = 0;
+}
+
+auto GLAD_API_PTR nullGetProgramResourceLocation(GLuint program, GLenum, const GLchar *) -> GLint
+{
+    ++g_call_counts[s_GetProgramResourceLocation];
+    validateName(g_programs, program, "glGetProgramResourceLocation");
+    return -1;
+}
+
+auto GLAD_API_PTR nullGetProgramResourceIndex(GLuint program, GLenum, const GLchar *) -> GLuint
+{
+    ++g_call_counts[s_GetProgramResourceIndex];
+    validateName(g_programs, program, "glGetProgramResourceIndex");
+    return GL_INVALID_INDEX;
+}
+
+auto GLAD_API_PTR nullGetProgramResourceLocationIndex(GLuint program, GLenum, const GLchar *) -> GLint
+{
+    ++g_call_counts[s_GetProgramResourceLocationIndex];
+    validateName(g_programs, program, "glGetProgramResourceLocationIndex");
+    return -1;
+}
+
+void GLAD_API_PTR nullNamedBufferData(GLuint buffer, GLsizeiptr size, const void *, GLenum)
+{
+    ++g_call_counts[s_NamedBufferData];
+
+    auto &state = getBuffer(buffer, "glNamedBufferData");
+    if (g_validate && state.immutable)
+        throw Error("glNamedBufferData: buffer storage is immutable");
+
+    state.storage.resize(size);
+}
+
+void GLAD_API_PTR nullNamedBufferStorage(GLuint buffer, GLsizeiptr size, const void *, GLbitfield)
+{
+    ++g_call_counts[s_NamedBufferStorage];
+
+    auto &state = getBuffer(buffer, "glNamedBufferStorage");
+    if (g_validate && state.immutable)
+        throw Error("glNamedBufferStorage: buffer storage is immutable");
+
+    state.storage.resize(size);
+    state.immutable = true;
+}
+
+auto getBufferParameter(GLuint buffer, GLenum pname, const char *function) -> GLint64
+{
+    const auto &state = getBuffer(buffer, function);
+
+    switch (pname)
+    {
+        case GL_BUFFER_SIZE:
+            return static_cast<GLint64>(state.storage.size());
+        case GL_BUFFER_IMMUTABLE_STORAGE:
+            return state.immutable;
+        case GL_BUFFER_USAGE:
+            return GL_STATIC_DRAW;
+        default:
+            return 0;
+    }
+}
+
+void GLAD_API_PTR nullGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint *params)
+{
+    ++g_call_counts[s_GetNamedBufferParameteriv];
+    *params = static_cast<GLint>(getBufferParameter(buffer, pname, "glGetNamedBufferParameteriv"));
+}
+
+void GLAD_API_PTR nullGetNamedBufferParameteri64v(GLuint buffer, GLenum pname, GLint64 *params)
+{
+    ++g_call_counts[s_GetNamedBufferParameteri64v];
+    *params = getBufferParameter(buffer, pname, "glGetNamedBufferParameteri64v");
+}
+
+auto GLAD_API_PTR nullMapNamedBuffer(GLuint buffer, GLenum) -> void *
+{
+    ++g_call_counts[s_MapNamedBuffer];
+    return getBuffer(buffer, "glMapNamedBuffer").storage.data();
+}
+
+auto GLAD_API_PTR nullMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield) -> void *
+{
+    ++g_call_counts[s_MapNamedBufferRange];
+
+    auto &storage = getBuffer(buffer, "glMapNamedBufferRange").storage;
+    if (g_validate && (offset < 0 || length < 0 || std::size_t(offset + length) > storage.size()))
+        throw Error("glMapNamedBufferRange: range is outside of the buffer's storage");
+
+    return storage.data() + offset;
+}
+
+auto GLAD_API_PTR nullUnmapNamedBuffer(GLuint buffer) -> GLboolean
+{
+    ++g_call_counts[s_UnmapNamedBuffer];
+    getBuffer(buffer, "glUnmapNamedBuffer");
+    return GL_TRUE;
+}
+
+auto GLAD_API_PTR nullFenceSync(GLenum, GLbitfield) -> GLsync
+{
+    ++g_call_counts[s_FenceSync];
+    return reinterpret_cast<GLsync>(g_next_sync++);
+}
+
+auto GLAD_API_PTR nullClientWaitSync(GLsync, GLbitfield, GLuint64) -> GLenum
+{
+    ++g_call_counts[s_ClientWaitSync];
+    return GL_ALREADY_SIGNALED;
+}
+
+struct ProcEntry
+{
+    const char *name;
+    GLADapiproc proc;
+};
+
+// indexed by counter slot
+const ProcEntry g_procs[proc_count]
+{
+#define GLUTILS_NULL_SPECIAL_ENTRY(NAME) {"gl" #NAME, reinterpret_cast<GLADapiproc>(null##NAME)},
+        GLUTILS_NULL_SPECIAL_PROCS(GLUTILS_NULL_SPECIAL_ENTRY)
+#undef GLUTILS_NULL_SPECIAL_ENTRY
+#define GLUTILS_NULL_COUNTING_ENTRY(NAME) {"gl" #NAME, reinterpret_cast<GLADapiproc>( \
+        &CountingStub<special_proc_count + c_##NAME, decltype(glad_gl##NAME)>::call)},
+        GLUTILS_NULL_PROCS(GLUTILS_NULL_COUNTING_ENTRY)
+#undef GLUTILS_NULL_COUNTING_ENTRY
+};
+
+// Counter slot of the function @p name. Special implementations take precedence over counting stubs.
+auto findSlot(const char *name) -> std::optional<std::size_t>
+{
+    static const auto slots = []
+    {
+        std::unordered_map<std::string_view, std::size_t> slots;
+        for (std::size_t i = 0; i < proc_count; i++)
+            slots.try_emplace(g_procs[i].name, i);
+        return slots;
+    }();
+
+    const auto iter = slots.find(name);
+    if (iter == slots.end())
+        return std::nullopt;
+    return iter->second;
+}
+
+} // namespace
+
+auto getProcAddress(const char *name) -> GLADapiproc
+{
+    // glad treats a null pointer as a missing function, which is what extension functions are
+    const auto slot = findSlot(name);
+    return slot ? g_procs[*slot].proc : nullptr;
+}
+
+auto getCallCount(const char *name) -> std::size_t
+{
+    const auto slot = findSlot(name);
+    return slot ? g_call_counts[*slot] : 0;
+}
+
+auto getTotalCallCount() -> std::size_t
+{
+    std::size_t total = 0;
+    for (auto count: g_call_counts)
+        total += count;
+    return total;
+}
+
+void resetCallCounts()
+{
+    g_call_counts.fill(0);
+}
+
+void setValidation(bool enabled)
+{
+    g_validate = enabled;
+}
+
+} // GL::Null
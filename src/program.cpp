@@ -15,11 +15,50 @@ void ProgramHandle::destroy(ProgramHandle program)
     glDeleteProgram(program.getName());
 }
 
+auto ProgramHandle::createSeparable(ShaderHandle::Type type, GLsizei count, const GLchar *const *strings) -> ProgramHandle
+{
+    return ProgramHandle{glCreateShaderProgramv(static_cast<GLenum>(type), count, strings)};
+}
+
 auto ProgramHandle::getParameter(ProgramHandle::Parameter parameter) const -> GLint
 {
-    GLint value;
-    glGetProgramiv(getName(), static_cast<GLenum>(parameter), &value);
-    return value;
+    // compute_work_group_size writes three values
+    GLint value[3]{};
+    glGetProgramiv(getName(), static_cast<GLenum>(parameter), value);
+    return value[0];
+}
+
+auto ProgramHandle::getComputeWorkGroupSize() const -> std::array<GLint, 3>
+{
+    std::array<GLint, 3> size{};
+    glGetProgramiv(getName(), GL_COMPUTE_WORK_GROUP_SIZE, size.data());
+    return size;
+}
+
+void ProgramHandle::dispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
+{
+    glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+}
+
+void ProgramHandle::dispatchComputeIndirect(BufferHandle buffer, GLintptr offset)
+{
+    glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer.getName());
+    glDispatchComputeIndirect(offset);
+}
+
+void ProgramHandle::setParameter(ProgramHandle::Parameter parameter, GLint value) const
+{
+    glProgramParameteri(getName(), static_cast<GLenum>(parameter), value);
+}
+
+void ProgramHandle::getBinary(GLsizei buf_size, GLsizei *length, GLenum *binary_format, void *binary) const
+{
+    glGetProgramBinary(getName(), buf_size, length, binary_format, binary);
+}
+
+void ProgramHandle::setBinary(GLenum binary_format, const void *binary, GLsizei length) const
+{
+    glProgramBinary(getName(), binary_format, binary, length);
 }
 
 void ProgramHandle::getInfoLog(GLsizei max_length, GLsizei *length, GLchar *info_log) const
@@ -56,7 +95,7 @@ auto ProgramHandle::getResourceLocationIndex(Interface interface, const char *na
     return glGetProgramResourceLocationIndex(getName(), static_cast<GLenum>(interface), name);
 }
 
-auto
+void
 ProgramHandle::getResourceName(Interface interface, GLuint index, GLsizei buf_size, GLsizei *length, char *name) const
 {
     glGetProgramResourceName(getName(), static_cast<GLenum>(interface), index, buf_size, length, name);
@@ -82,6 +121,12 @@ void ProgramHandle::link() const
     glLinkProgram(getName());
 }
 
+void ProgramHandle::setTransformFeedbackVaryings(GLsizei count, const GLchar *const *varyings,
+                                                 TransformFeedbackBufferMode buffer_mode) const
+{
+    glTransformFeedbackVaryings(getName(), count, varyings, static_cast<GLenum>(buffer_mode));
+}
+
 void ProgramHandle::attachShader(ShaderHandle shader) const
 {
     glAttachShader(getName(), shader.getName());
@@ -110,7 +155,7 @@ void ProgramHandle::bindAttribLocation(GLuint index, const char *name) const
     glBindAttribLocation(m_name, index, name);
 }
 
-#define GLUTILS_PROGRAM_UNIFORM(N, SUFFIX) glProgramUniform##N##SUFFIX
+#define GLUTILS_PROGRAM_UNIFORM(N, SUFFIX) &glProgramUniform##N##SUFFIX
 #define GLUTILS_PROGRAM_UNIFORM_FUNCTIONS_DEFINITION(TYPE, TYPE_SUFFIX) \
     template<> const Program::GLProgramUniformFunctions<TYPE> ProgramHandle::s_program_uniform_functions<TYPE> \
     {                                                                   \
@@ -120,7 +165,7 @@ void ProgramHandle::bindAttribLocation(GLuint index, const char *name) const
         GLUTILS_PROGRAM_UNIFORM(4, TYPE_SUFFIX)                         \
     };
 
-#define GLUTILS_PROGRAM_UNIFORM_V(N, SUFFIX) glProgramUniform##N##SUFFIX##v
+#define GLUTILS_PROGRAM_UNIFORM_V(N, SUFFIX) &glProgramUniform##N##SUFFIX##v
 #define GLUTILS_PROGRAM_UNIFORM_V_FUNCTIONS_DEFINITION(TYPE, SUFFIX) \
     template<> const Program::GLProgramUniformvFunctions<TYPE> ProgramHandle::s_program_uniform_v_functions<TYPE> \
     {                                                                \
@@ -139,7 +184,7 @@ GLUTILS_PROGRAM_UNIFORM_DEFINITIONS(double, d)
 GLUTILS_PROGRAM_UNIFORM_DEFINITIONS(int, i)
 GLUTILS_PROGRAM_UNIFORM_DEFINITIONS(unsigned int, ui)
 
-#define GLUTILS_PROGRAM_UNIFORM_MATRIX(DIM, SUFFIX) glProgramUniformMatrix##DIM##SUFFIX##v
+#define GLUTILS_PROGRAM_UNIFORM_MATRIX(DIM, SUFFIX) &glProgramUniformMatrix##DIM##SUFFIX##v
 #define GLUTILS_PROGRAM_UNIFORM_MATRIX_FUNCTIONS_DEFINITION(TYPE, SUFFIX) \
     template<> const ProgramHandle::GLProgramUniformMatrixFunctions<TYPE> ProgramHandle::s_program_uniform_matrix_functions<TYPE>  = \
     {                                                                     \
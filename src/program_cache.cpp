@@ -0,0 +1,335 @@
+#include "glutils/program_cache.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/hash.hpp"
+#include "glutils/limits.hpp"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace GL {
+
+struct ProgramCache::Header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t capacity;
+    std::uint32_t count;
+    std::uint64_t data_end;
+};
+
+struct ProgramCache::Entry
+{
+    std::uint64_t key;
+    std::uint64_t offset;
+    std::uint32_t size;
+    std::uint32_t format;
+};
+
+namespace {
+
+constexpr std::uint32_t cache_magic = 0x43554c47; // "GLUC"
+constexpr std::uint32_t cache_version = 1;
+
+/// Holds an flock() on a file for the duration of a scope.
+class FileLock
+{
+public:
+    FileLock(int fd, int operation) : m_fd(fd)
+    {
+        if (flock(m_fd, operation) != 0)
+            throw Error("failed to lock program cache file");
+    }
+
+    ~FileLock()
+    {
+        flock(m_fd, LOCK_UN);
+    }
+
+    FileLock(const FileLock &) = delete;
+
+    FileLock &operator=(const FileLock &) = delete;
+
+private:
+    int m_fd;
+};
+
+// zero marks an empty index entry
+auto nonZeroKey(std::uint64_t key) -> std::uint64_t
+{
+    return key ? key : 1;
+}
+
+} // namespace
+
+ProgramCache::ProgramCache(const std::string &path, std::uint32_t capacity)
+{
+    m_fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0)
+        throw Error("failed to open program cache file " + path);
+
+    try
+    {
+        FileLock lock(m_fd, LOCK_EX);
+
+        struct stat file_stat{};
+        if (fstat(m_fd, &file_stat) != 0)
+            throw Error("failed to stat program cache file " + path);
+
+        if (file_stat.st_size == 0)
+        {
+            std::uint32_t pow2_capacity = 1;
+            while (pow2_capacity < capacity)
+                pow2_capacity <<= 1;
+
+            const std::size_t size = sizeof(Header) + pow2_capacity * sizeof(Entry);
+            if (ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+                throw Error("failed to allocate program cache file " + path);
+
+            remap(size);
+            header() = Header{cache_magic, cache_version, pow2_capacity, 0, size};
+        }
+        else
+        {
+            if (static_cast<std::size_t>(file_stat.st_size) < sizeof(Header))
+                throw Error(path + " is not a program cache file");
+
+            remap(file_stat.st_size);
+
+            if (header().magic != cache_magic || header().version != cache_version)
+                throw Error(path + " is not a program cache file, or was created by another version of glutils");
+
+            // the index is addressed with capacity - 1 as a mask
+            const auto capacity = header().capacity;
+            const auto data_start = sizeof(Header) + std::uint64_t(capacity) * sizeof(Entry);
+            if (capacity == 0 || (capacity & (capacity - 1)) != 0 || std::uint64_t(file_stat.st_size) < data_start
+                || header().data_end < data_start || header().data_end > std::uint64_t(file_stat.st_size))
+                throw Error(path + " is a corrupt program cache file");
+        }
+    }
+    catch (...)
+    {
+        if (m_map)
+            munmap(m_map, m_map_size);
+        close(m_fd);
+        throw;
+    }
+}
+
+ProgramCache::~ProgramCache()
+{
+    munmap(m_map, m_map_size);
+    close(m_fd);
+}
+
+auto ProgramCache::makeKey(const std::vector<ShaderSource> &sources) -> std::uint64_t
+{
+    const auto &limits = getLimits();
+
+    auto key = hash(limits.vendor);
+    key = hash(limits.renderer, key);
+    key = hash(limits.version, key);
+
+    for (const auto &[type, source]: sources)
+    {
+        key = hash(static_cast<std::uint64_t>(type), key);
+        key = hash(source.size(), key);
+        key = hash(source, key);
+    }
+
+    return nonZeroKey(key);
+}
+
+bool ProgramCache::load(ProgramHandle program, std::uint64_t key) const
+{
+    key = nonZeroKey(key);
+
+    FileLock lock(m_fd, LOCK_SH);
+
+    if (!mapData())
+        return false;
+
+    const auto mask = header().capacity - 1;
+    for (std::uint32_t i = 0; i < header().capacity; i++)
+    {
+        const Entry &entry = entries()[(key + i) & mask];
+
+        if (entry.key == 0)
+            return false;
+
+        if (entry.key == key)
+        {
+            // a corrupt entry; treat it like a binary the driver rejected, so link() stores it again
+            if (entry.offset + entry.size > header().data_end)
+                return false;
+
+            program.setBinary(entry.format, static_cast<const unsigned char *>(m_map) + entry.offset,
+                              static_cast<GLsizei>(entry.size));
+            return program.getParameter(ProgramHandle::Parameter::link_status) == GL_TRUE;
+        }
+    }
+
+    return false;
+}
+
+bool ProgramCache::store(ProgramHandle program, std::uint64_t key)
+{
+    key = nonZeroKey(key);
+
+    const auto length = program.getParameter(ProgramHandle::Parameter::program_binary_length);
+    if (length <= 0)
+        return false;
+
+    std::vector<unsigned char> binary(length);
+    GLsizei written = 0;
+    GLenum format = 0;
+    program.getBinary(length, &written, &format, binary.data());
+    if (written <= 0)
+        return false;
+
+    FileLock lock(m_fd, LOCK_EX);
+
+    if (!mapData())
+        return false;
+
+    const auto mask = header().capacity - 1;
+    Entry *slot = nullptr;
+    for (std::uint32_t i = 0; i < header().capacity && !slot; i++)
+    {
+        Entry &entry = entries()[(key + i) & mask];
+
+        if (entry.key == key || entry.key == 0)
+            slot = &entry;
+    }
+
+    if (!slot)
+        return false;
+
+    // An existing entry is replaced, since link() only stores after load() failed: the driver rejected the binary,
+    // e.g. after an update that kept its version strings, or the entry is corrupt. Unless another process stored the
+    // same binary in the meantime.
+    const bool replace = slot->key == key;
+    if (replace && slot->size == static_cast<std::uint32_t>(written) && slot->format == format
+        && slot->offset + slot->size <= header().data_end
+        && std::memcmp(static_cast<const unsigned char *>(m_map) + slot->offset, binary.data(), written) == 0)
+        return false;
+
+    const auto offset = header().data_end;
+    const auto data_end = offset + written;
+    const auto slot_index = slot - entries();
+
+    if (ftruncate(m_fd, static_cast<off_t>(data_end)) != 0)
+        return false;
+    remap(data_end);
+
+    std::memcpy(static_cast<unsigned char *>(m_map) + offset, binary.data(), written);
+
+    // the key is written last, so that a new entry is never visible half-filled. The data of a replaced binary stays
+    // in the file.
+    Entry &entry = entries()[slot_index];
+    entry.offset = offset;
+    entry.size = written;
+    entry.format = format;
+    entry.key = key;
+
+    if (!replace)
+        header().count++;
+    header().data_end = data_end;
+
+    return true;
+}
+
+bool ProgramCache::link(ProgramHandle program, const std::vector<ShaderSource> &sources)
+{
+    const auto key = makeKey(sources);
+
+    if (load(program, key))
+        return true;
+
+    m_shader_log.clear();
+
+    std::vector<Shader> shaders;
+    shaders.reserve(sources.size());
+
+    for (const auto &[type, source]: sources)
+    {
+        auto &shader = shaders.emplace_back(type);
+
+        const GLchar *string = source.data();
+        const auto length = static_cast<GLint>(source.size());
+        shader.setSource(1, &string, &length);
+        shader.compile();
+
+        if (shader.getParameter(ShaderHandle::Parameter::compile_status) != GL_TRUE)
+            m_shader_log += shader.getInfoLog();
+
+        program.attachShader(shader);
+    }
+
+    program.setParameter(ProgramHandle::Parameter::program_binary_retrievable_hint, GL_TRUE);
+    program.link();
+
+    for (const auto &shader: shaders)
+        program.detachShader(shader);
+
+    const bool linked = program.getParameter(ProgramHandle::Parameter::link_status) == GL_TRUE;
+
+    if (linked)
+        store(program, key);
+
+    return linked;
+}
+
+auto ProgramCache::getEntryCount() const -> std::uint32_t
+{
+    FileLock lock(m_fd, LOCK_SH);
+    return header().count;
+}
+
+bool ProgramCache::mapData() const
+{
+    // another process may have appended binaries since the file was last mapped
+    if (header().data_end <= m_map_size)
+        return true;
+
+    // mapping past the end of the file would fault on access
+    struct stat file_stat{};
+    if (fstat(m_fd, &file_stat) != 0 || header().data_end > std::uint64_t(file_stat.st_size))
+        return false;
+
+    remap(header().data_end);
+    return true;
+}
+
+void ProgramCache::remap(std::size_t size) const
+{
+    if (m_map)
+        munmap(m_map, m_map_size);
+
+    m_map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_map == MAP_FAILED)
+    {
+        m_map = nullptr;
+        m_map_size = 0;
+        throw Error("failed to map program cache file");
+    }
+
+    m_map_size = size;
+}
+
+auto ProgramCache::header() const -> ProgramCache::Header &
+{
+    return *static_cast<Header *>(m_map);
+}
+
+auto ProgramCache::entries() const -> ProgramCache::Entry *
+{
+    return reinterpret_cast<Entry *>(static_cast<unsigned char *>(m_map) + sizeof(Header));
+}
+
+} // GL
@@ -0,0 +1,246 @@
+#include "glutils/program_compiler.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace GL {
+
+namespace {
+
+using MaxShaderCompilerThreadsProc = void (GLAD_API_PTR *)(GLuint count);
+
+} // namespace
+
+ProgramCompiler::ProgramCompiler(std::vector<MakeContextCurrent> worker_contexts)
+{
+    const auto &limits = getLimits();
+
+    MaxShaderCompilerThreadsProc max_threads = nullptr;
+    if (limits.hasExtension("GL_KHR_parallel_shader_compile"))
+        max_threads = reinterpret_cast<MaxShaderCompilerThreadsProc>(getProcAddress("glMaxShaderCompilerThreadsKHR"));
+    else if (limits.hasExtension("GL_ARB_parallel_shader_compile"))
+        max_threads = reinterpret_cast<MaxShaderCompilerThreadsProc>(getProcAddress("glMaxShaderCompilerThreadsARB"));
+
+    if (max_threads)
+    {
+        // let the implementation pick the number of threads
+        max_threads(0xFFFFFFFF);
+        m_driver_parallel = true;
+        return;
+    }
+
+    m_workers.reserve(worker_contexts.size());
+    for (auto &make_current: worker_contexts)
+        m_workers.emplace_back([this, make_current = std::move(make_current)] { work(make_current); });
+}
+
+ProgramCompiler::~ProgramCompiler()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_available.notify_all();
+
+    for (auto &worker: m_workers)
+        worker.join();
+}
+
+void ProgramCompiler::submit(ProgramHandle program, const std::vector<ShaderSource> &sources)
+{
+    m_pending_count++;
+
+    Job job{program, {}, {}};
+
+    if (m_driver_parallel || m_workers.empty())
+    {
+        issue(job, sources);
+        m_issued.emplace_back(std::move(job));
+        return;
+    }
+
+    job.sources.reserve(sources.size());
+    for (const auto &[type, source]: sources)
+        job.sources.push_back({type, std::string(source)});
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_queue.emplace_back(std::move(job));
+    }
+    m_job_available.notify_one();
+}
+
+auto ProgramCompiler::poll() -> std::vector<Result>
+{
+    std::vector<Result> results;
+
+    auto iter = m_issued.begin();
+    while (iter != m_issued.end())
+    {
+        if (m_driver_parallel
+            && iter->program.getParameter(ProgramHandle::Parameter::completion_status) != GL_TRUE)
+        {
+            ++iter;
+            continue;
+        }
+
+        results.emplace_back(complete(*iter));
+        iter = m_issued.erase(iter);
+    }
+
+    if (!m_workers.empty())
+    {
+        std::lock_guard lock(m_mutex);
+        std::move(m_done.begin(), m_done.end(), std::back_inserter(results));
+        m_done.clear();
+    }
+
+    m_pending_count -= results.size();
+
+    return results;
+}
+
+auto ProgramCompiler::wait(ProgramHandle program) -> Result
+{
+    const auto job = std::find_if(m_issued.begin(), m_issued.end(),
+                                  [&](const Job &j) { return j.program == program; });
+    if (job != m_issued.end())
+    {
+        // querying the link status waits for the driver
+        auto result = complete(*job);
+        m_issued.erase(job);
+        m_pending_count--;
+        return result;
+    }
+
+    if (m_workers.empty())
+        throw Error("program is not pending");
+
+    const auto isDone = [&](const Result &r) { return r.program == program; };
+    const auto isQueued = [&](const Job &j) { return j.program == program; };
+
+    std::unique_lock lock(m_mutex);
+    m_job_done.wait(lock, [&] {
+        return std::any_of(m_done.begin(), m_done.end(), isDone)
+               || (m_in_progress == 0 && std::none_of(m_queue.begin(), m_queue.end(), isQueued));
+    });
+
+    const auto done = std::find_if(m_done.begin(), m_done.end(), isDone);
+    if (done == m_done.end())
+        throw Error("program is not pending");
+
+    auto result = std::move(*done);
+    m_done.erase(done);
+    m_pending_count--;
+    return result;
+}
+
+auto ProgramCompiler::finish() -> std::vector<Result>
+{
+    if (!m_workers.empty())
+    {
+        std::unique_lock lock(m_mutex);
+        m_job_done.wait(lock, [this] { return m_queue.empty() && m_in_progress == 0; });
+    }
+
+    std::vector<Result> results;
+
+    for (auto &job: m_issued)
+        results.emplace_back(complete(job));
+    m_issued.clear();
+
+    if (!m_workers.empty())
+    {
+        std::lock_guard lock(m_mutex);
+        std::move(m_done.begin(), m_done.end(), std::back_inserter(results));
+        m_done.clear();
+    }
+
+    m_pending_count -= results.size();
+
+    return results;
+}
+
+void ProgramCompiler::issue(Job &job, const std::vector<ShaderSource> &sources)
+{
+    job.shaders.reserve(sources.size());
+
+    for (const auto &[type, source]: sources)
+    {
+        auto &shader = job.shaders.emplace_back(type);
+
+        const GLchar *string = source.data();
+        const auto length = static_cast<GLint>(source.size());
+        shader.setSource(1, &string, &length);
+        shader.compile();
+
+        job.program.attachShader(shader);
+    }
+
+    // linking doesn't have to wait for compilation; the driver will queue it.
+    job.program.link();
+}
+
+auto ProgramCompiler::complete(Job &job) -> Result
+{
+    Result result{job.program, false, {}};
+
+    for (const auto &shader: job.shaders)
+    {
+        if (shader.getParameter(ShaderHandle::Parameter::compile_status) != GL_TRUE)
+            result.info_log += shader.getInfoLog();
+
+        job.program.detachShader(shader);
+    }
+    job.shaders.clear();
+
+    result.linked = job.program.getParameter(ProgramHandle::Parameter::link_status) == GL_TRUE;
+    result.info_log += job.program.getInfoLog();
+
+    return result;
+}
+
+void ProgramCompiler::work(const MakeContextCurrent &make_current)
+{
+    make_current();
+
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock lock(m_mutex);
+            m_job_available.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+            if (m_stop)
+                return;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_in_progress++;
+        }
+
+        std::vector<ShaderSource> sources;
+        sources.reserve(job.sources.size());
+        for (const auto &[type, source]: job.sources)
+            sources.push_back({type, source});
+
+        issue(job, sources);
+        auto result = complete(job);
+
+        // make the program's new state visible to the main context before reporting it
+        glFinish();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_done.emplace_back(std::move(result));
+            m_in_progress--;
+        }
+        m_job_done.notify_all();
+    }
+}
+
+} // GL
@@ -0,0 +1,101 @@
+#include "glutils/program_pipeline.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/hash.hpp"
+
+namespace GL {
+
+auto ProgramPipelineHandle::create() -> ProgramPipelineHandle
+{
+    GLuint name;
+    glCreateProgramPipelines(1, &name);
+    return ProgramPipelineHandle{name};
+}
+
+void ProgramPipelineHandle::destroy(ProgramPipelineHandle pipeline)
+{
+    glDeleteProgramPipelines(1, &pipeline.m_name);
+}
+
+void ProgramPipelineHandle::bind() const
+{
+    glBindProgramPipeline(m_name);
+}
+
+void ProgramPipelineHandle::useProgramStages(Stages stages, ProgramHandle program) const
+{
+    glUseProgramStages(m_name, static_cast<GLbitfield>(stages), program.getName());
+}
+
+void ProgramPipelineHandle::setActiveProgram(ProgramHandle program) const
+{
+    glActiveShaderProgram(m_name, program.getName());
+}
+
+void ProgramPipelineHandle::validate() const
+{
+    glValidateProgramPipeline(m_name);
+}
+
+auto ProgramPipelineHandle::getParameter(Parameter parameter) const -> GLint
+{
+    GLint value;
+    glGetProgramPipelineiv(m_name, static_cast<GLenum>(parameter), &value);
+    return value;
+}
+
+std::string ProgramPipelineHandle::getInfoLog() const
+{
+    const auto length = getParameter(Parameter::info_log_length);
+
+    if (length <= 0)
+        return {};
+
+    std::string log(length, '\0');
+    glGetProgramPipelineInfoLog(m_name, length, nullptr, log.data());
+
+    return log;
+}
+
+auto operator|(ProgramPipelineHandle::Stages l, ProgramPipelineHandle::Stages r) -> ProgramPipelineHandle::Stages
+{
+    return static_cast<ProgramPipelineHandle::Stages>(static_cast<GLbitfield>(l) | static_cast<GLbitfield>(r));
+}
+
+auto ProgramPipelineCache::get(const PipelineStages &stages) -> ProgramPipelineHandle
+{
+    const Key key{stages.vertex.getName(), stages.tess_control.getName(), stages.tess_evaluation.getName(),
+                  stages.geometry.getName(), stages.fragment.getName(), stages.compute.getName()};
+
+    const auto iter = m_pipelines.find(key);
+    if (iter != m_pipelines.end())
+        return iter->second;
+
+    using Stages = ProgramPipelineHandle::Stages;
+
+    ProgramPipeline pipeline;
+    const std::pair<Stages, ProgramHandle> stage_programs[]
+            {
+                    {Stages::vertex, stages.vertex},
+                    {Stages::tess_control, stages.tess_control},
+                    {Stages::tess_evaluation, stages.tess_evaluation},
+                    {Stages::geometry, stages.geometry},
+                    {Stages::fragment, stages.fragment},
+                    {Stages::compute, stages.compute},
+            };
+
+    for (const auto &[stage, program]: stage_programs)
+        if (program)
+            pipeline.useProgramStages(stage, program);
+
+    return m_pipelines.emplace(key, std::move(pipeline)).first->second;
+}
+
+auto ProgramPipelineCache::KeyHash::operator()(const Key &key) const -> std::size_t
+{
+    std::uint64_t value = hash("");
+    for (const auto name: key)
+        value = hash(name, value);
+    return static_cast<std::size_t>(value);
+}
+
+} // GL
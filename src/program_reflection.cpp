@@ -0,0 +1,191 @@
+#include "glutils/program_reflection.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace GL {
+
+namespace {
+
+using Interface = ProgramReflection::Interface;
+using Resource = ProgramReflection::Resource;
+
+constexpr std::array reflected_interfaces
+        {
+                Interface::uniform,
+                Interface::uniform_block,
+                Interface::shader_storage_block,
+                Interface::program_input,
+                Interface::buffer_variable
+        };
+
+/// A resource property and where its value is stored in a Resource.
+struct Property
+{
+    GLenum property;
+    GLint Resource::*member;
+};
+
+constexpr std::array variable_properties
+        {
+                Property{GL_TYPE, nullptr},
+                Property{GL_ARRAY_SIZE, &Resource::array_size},
+                Property{GL_LOCATION, &Resource::location},
+                Property{GL_OFFSET, &Resource::offset},
+                Property{GL_ARRAY_STRIDE, &Resource::array_stride},
+                Property{GL_MATRIX_STRIDE, &Resource::matrix_stride},
+                Property{GL_BLOCK_INDEX, &Resource::block_index},
+        };
+
+constexpr std::array buffer_variable_properties
+        {
+                Property{GL_TYPE, nullptr},
+                Property{GL_ARRAY_SIZE, &Resource::array_size},
+                Property{GL_OFFSET, &Resource::offset},
+                Property{GL_ARRAY_STRIDE, &Resource::array_stride},
+                Property{GL_MATRIX_STRIDE, &Resource::matrix_stride},
+                Property{GL_BLOCK_INDEX, &Resource::block_index},
+                Property{GL_TOP_LEVEL_ARRAY_SIZE, &Resource::top_level_array_size},
+                Property{GL_TOP_LEVEL_ARRAY_STRIDE, &Resource::top_level_array_stride},
+        };
+
+constexpr std::array input_properties
+        {
+                Property{GL_TYPE, nullptr},
+                Property{GL_ARRAY_SIZE, &Resource::array_size},
+                Property{GL_LOCATION, &Resource::location},
+        };
+
+constexpr std::array block_properties
+        {
+                Property{GL_BUFFER_BINDING, &Resource::buffer_binding},
+                Property{GL_BUFFER_DATA_SIZE, &Resource::buffer_data_size},
+                Property{GL_NUM_ACTIVE_VARIABLES, &Resource::active_variables},
+        };
+
+template<std::size_t N>
+void queryProperties(ProgramHandle program, Resource &resource, const std::array<Property, N> &properties)
+{
+    std::array<GLenum, N> enums{};
+    for (std::size_t i = 0; i < N; i++)
+        enums[i] = properties[i].property;
+
+    std::array<GLint, N> values{};
+    values.fill(-1);
+    program.getResource(resource.interface, resource.index, N, enums.data(), N, nullptr, values.data());
+
+    for (std::size_t i = 0; i < N; i++)
+    {
+        if (properties[i].member)
+            resource.*properties[i].member = values[i];
+        else
+            resource.type = static_cast<GLenum>(values[i]);
+    }
+}
+
+auto trimArraySuffix(std::string_view name) -> std::string_view
+{
+    constexpr std::string_view suffix = "[0]";
+
+    if (name.size() > suffix.size() && name.substr(name.size() - suffix.size()) == suffix)
+        name.remove_suffix(suffix.size());
+
+    return name;
+}
+
+} // namespace
+
+ProgramReflection::ProgramReflection(ProgramHandle program)
+{
+    std::string name_buffer;
+
+    for (const auto interface: reflected_interfaces)
+    {
+        const auto count = program.getInterface(static_cast<GLenum>(interface), GL_ACTIVE_RESOURCES);
+        const auto max_name_length = program.getInterface(static_cast<GLenum>(interface), GL_MAX_NAME_LENGTH);
+        name_buffer.resize(std::max(max_name_length, 1));
+
+        for (GLint index = 0; index < count; index++)
+        {
+            auto &resource = m_resources.emplace_back(Resource{interface, static_cast<GLuint>(index), {}, 0});
+
+            GLsizei name_length = 0;
+            program.getResourceName(interface, index, static_cast<GLsizei>(name_buffer.size()), &name_length,
+                                    name_buffer.data());
+            resource.name.assign(name_buffer.data(), name_length);
+            resource.key = hash(trimArraySuffix(resource.name));
+
+            switch (interface)
+            {
+                case Interface::uniform:
+                    queryProperties(program, resource, variable_properties);
+                    break;
+                case Interface::buffer_variable:
+                    queryProperties(program, resource, buffer_variable_properties);
+                    break;
+                case Interface::program_input:
+                    queryProperties(program, resource, input_properties);
+                    break;
+                default:
+                    queryProperties(program, resource, block_properties);
+            }
+        }
+    }
+
+    std::size_t slot_count = 1;
+    while (slot_count < m_resources.size() * 2)
+        slot_count <<= 1;
+    m_slots.assign(slot_count, 0);
+
+    for (std::uint32_t i = 0; i < m_resources.size(); i++)
+        insert(i);
+}
+
+auto ProgramReflection::find(Interface interface, std::uint64_t key) const -> const Resource *
+{
+    if (m_resources.empty())
+        return nullptr;
+
+    const auto mask = m_slots.size() - 1;
+    for (auto slot = slotKey(interface, key) & mask;; slot = (slot + 1) & mask)
+    {
+        const auto resource_index = m_slots[slot];
+        if (resource_index == 0)
+            return nullptr;
+
+        const auto &resource = m_resources[resource_index - 1];
+        if (resource.key == key && resource.interface == interface)
+            return &resource;
+    }
+}
+
+auto ProgramReflection::getResources(Interface interface) const -> std::pair<const Resource *, const Resource *>
+{
+    const auto begin = std::find_if(m_resources.begin(), m_resources.end(),
+                                    [interface](const Resource &r) { return r.interface == interface; });
+    const auto end = std::find_if(begin, m_resources.end(),
+                                  [interface](const Resource &r) { return r.interface != interface; });
+
+    return {m_resources.data() + (begin - m_resources.begin()), m_resources.data() + (end - m_resources.begin())};
+}
+
+auto ProgramReflection::slotKey(Interface interface, std::uint64_t key) -> std::uint64_t
+{
+    // keys are already well mixed; the interface only needs to move resources of different interfaces apart
+    return key ^ (static_cast<std::uint64_t>(interface) * 0x9E3779B97F4A7C15);
+}
+
+void ProgramReflection::insert(std::uint32_t resource_index)
+{
+    const auto &resource = m_resources[resource_index];
+
+    const auto mask = m_slots.size() - 1;
+    auto slot = slotKey(resource.interface, resource.key) & mask;
+    while (m_slots[slot] != 0)
+        slot = (slot + 1) & mask;
+
+    m_slots[slot] = resource_index + 1;
+}
+
+} // GL
@@ -0,0 +1,76 @@
+#include "glutils/sampler.hpp"
+#include "glutils/gl.hpp"
+
+namespace GL {
+
+auto SamplerHandle::create() -> SamplerHandle
+{
+    SamplerHandle new_handle;
+    glCreateSamplers(1, &new_handle.m_name);
+    return new_handle;
+}
+
+void SamplerHandle::destroy(SamplerHandle sampler)
+{
+    glDeleteSamplers(1, &sampler.m_name);
+}
+
+void SamplerHandle::setMinFilter(MinFilter filter) const
+{
+    glSamplerParameteri(m_name, GL_TEXTURE_MIN_FILTER, GLint(filter));
+}
+
+void SamplerHandle::setMagFilter(MagFilter filter) const
+{
+    glSamplerParameteri(m_name, GL_TEXTURE_MAG_FILTER, GLint(filter));
+}
+
+void SamplerHandle::setWrap(Wrap s, Wrap t, Wrap r) const
+{
+    glSamplerParameteri(m_name, GL_TEXTURE_WRAP_S, GLint(s));
+    glSamplerParameteri(m_name, GL_TEXTURE_WRAP_T, GLint(t));
+    glSamplerParameteri(m_name, GL_TEXTURE_WRAP_R, GLint(r));
+}
+
+void SamplerHandle::setMaxAnisotropy(GLfloat anisotropy) const
+{
+    glSamplerParameterf(m_name, GL_TEXTURE_MAX_ANISOTROPY, anisotropy);
+}
+
+void SamplerHandle::setLodBias(GLfloat bias) const
+{
+    glSamplerParameterf(m_name, GL_TEXTURE_LOD_BIAS, bias);
+}
+
+void SamplerHandle::setLodRange(GLfloat min, GLfloat max) const
+{
+    glSamplerParameterf(m_name, GL_TEXTURE_MIN_LOD, min);
+    glSamplerParameterf(m_name, GL_TEXTURE_MAX_LOD, max);
+}
+
+void SamplerHandle::setCompareMode(CompareMode mode) const
+{
+    glSamplerParameteri(m_name, GL_TEXTURE_COMPARE_MODE, GLint(mode));
+}
+
+void SamplerHandle::setCompareFunc(CompareFunc func) const
+{
+    glSamplerParameteri(m_name, GL_TEXTURE_COMPARE_FUNC, GLint(func));
+}
+
+void SamplerHandle::setBorderColor(const std::array<GLfloat, 4> &color) const
+{
+    glSamplerParameterfv(m_name, GL_TEXTURE_BORDER_COLOR, color.data());
+}
+
+void SamplerHandle::bind(GLuint unit, SamplerHandle sampler)
+{
+    glBindSampler(unit, sampler.m_name);
+}
+
+void SamplerHandle::s_bindSamplers(GLuint first_unit, GLsizei count, const GLuint *samplers)
+{
+    glBindSamplers(first_unit, count, samplers);
+}
+
+} // GL
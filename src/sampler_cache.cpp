@@ -0,0 +1,95 @@
+#include "glutils/sampler_cache.hpp"
+#include "glutils/error.hpp"
+#include "glutils/hash.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+namespace GL {
+
+namespace {
+
+auto hashFloat(GLfloat value, std::uint64_t seed) -> std::uint64_t
+{
+    // -0 compares equal to 0, so it must hash the same
+    if (value == 0.0f)
+        value = 0.0f;
+
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return hash(bits, seed);
+}
+
+} // namespace
+
+auto SamplerDescription::getHash() const -> std::uint64_t
+{
+    auto value = hash(std::uint64_t(min_filter), 0xcbf29ce484222325);
+    value = hash(std::uint64_t(mag_filter), value);
+    value = hash(std::uint64_t(wrap_s), value);
+    value = hash(std::uint64_t(wrap_t), value);
+    value = hash(std::uint64_t(wrap_r), value);
+    value = hashFloat(max_anisotropy, value);
+    value = hashFloat(lod_bias, value);
+    value = hashFloat(min_lod, value);
+    value = hashFloat(max_lod, value);
+    value = hash(std::uint64_t(compare_mode), value);
+    value = hash(std::uint64_t(compare_func), value);
+    for (const auto component: border_color)
+        value = hashFloat(component, value);
+    return value;
+}
+
+bool operator==(const SamplerDescription &lhs, const SamplerDescription &rhs)
+{
+    return lhs.min_filter == rhs.min_filter && lhs.mag_filter == rhs.mag_filter && lhs.wrap_s == rhs.wrap_s
+           && lhs.wrap_t == rhs.wrap_t && lhs.wrap_r == rhs.wrap_r && lhs.max_anisotropy == rhs.max_anisotropy
+           && lhs.lod_bias == rhs.lod_bias && lhs.min_lod == rhs.min_lod && lhs.max_lod == rhs.max_lod
+           && lhs.compare_mode == rhs.compare_mode && lhs.compare_func == rhs.compare_func
+           && lhs.border_color == rhs.border_color;
+}
+
+bool operator!=(const SamplerDescription &lhs, const SamplerDescription &rhs)
+{
+    return !(lhs == rhs);
+}
+
+auto SamplerCache::get(SamplerDescription description) -> SamplerHandle
+{
+    // NaN compares unequal to itself, so such a description would never be found again
+    const GLfloat values[] = {description.max_anisotropy, description.lod_bias, description.min_lod,
+                              description.max_lod, description.border_color[0], description.border_color[1],
+                              description.border_color[2], description.border_color[3]};
+    if (std::any_of(std::begin(values), std::end(values), [](GLfloat value) { return std::isnan(value); }))
+        throw Error("sampler description with a NaN value");
+
+    description.max_anisotropy = std::clamp(description.max_anisotropy, 1.0f,
+                                            std::max(getLimits().max_texture_max_anisotropy, 1.0f));
+
+    const auto iter = m_samplers.find(description);
+    if (iter != m_samplers.end())
+    {
+        m_hit_count++;
+        return iter->second;
+    }
+
+    Sampler sampler;
+    sampler.setMinFilter(description.min_filter);
+    sampler.setMagFilter(description.mag_filter);
+    sampler.setWrap(description.wrap_s, description.wrap_t, description.wrap_r);
+    sampler.setMaxAnisotropy(description.max_anisotropy);
+    sampler.setLodBias(description.lod_bias);
+    sampler.setLodRange(description.min_lod, description.max_lod);
+    sampler.setCompareMode(description.compare_mode);
+    sampler.setCompareFunc(description.compare_func);
+    sampler.setBorderColor(description.border_color);
+
+    const SamplerHandle handle = sampler;
+    m_samplers.emplace(description, std::move(sampler));
+    return handle;
+}
+
+} // GL
@@ -23,6 +23,27 @@ void ShaderHandle::compile() const
     glCompileShader(getName());
 }
 
+void ShaderHandle::setBinary(GLenum binary_format, const void *binary, GLsizei length) const
+{
+    glShaderBinary(1, &m_name, binary_format, binary, length);
+}
+
+void ShaderHandle::setSpirV(const void *binary, GLsizei length) const
+{
+    setBinary(GL_SHADER_BINARY_FORMAT_SPIR_V, binary, length);
+}
+
+void ShaderHandle::specialize(const GLchar *entry_point, GLuint count, const GLuint *constant_indices,
+                              const GLuint *constant_values) const
+{
+    glSpecializeShader(m_name, entry_point, count, constant_indices, constant_values);
+}
+
+void ShaderHandle::specialize(const GLchar *entry_point, const SpecializationConstants &constants) const
+{
+    specialize(entry_point, constants.getCount(), constants.getIds(), constants.getValues());
+}
+
 auto ShaderHandle::getParameter(ShaderHandle::Parameter parameter) const -> GLint
 {
     GLint value;
@@ -0,0 +1,308 @@
+#include "glutils/shader_preprocessor.hpp"
+#include "glutils/error.hpp"
+#include "glutils/hash.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace GL {
+
+namespace {
+
+auto trimLeft(std::string_view string) -> std::string_view
+{
+    const auto begin = string.find_first_not_of(" \t");
+    return begin == std::string_view::npos ? std::string_view() : string.substr(begin);
+}
+
+/// If @p line is an #include directive, return the included name.
+bool parseInclude(std::string_view line, std::string_view &name)
+{
+    line = trimLeft(line);
+    if (line.empty() || line.front() != '#')
+        return false;
+
+    line = trimLeft(line.substr(1));
+    constexpr std::string_view directive = "include";
+    if (line.substr(0, directive.size()) != directive)
+        return false;
+
+    line = trimLeft(line.substr(directive.size()));
+    if (line.empty() || (line.front() != '"' && line.front() != '<'))
+        return false;
+
+    const char close = line.front() == '"' ? '"' : '>';
+    const auto end = line.find(close, 1);
+    if (end == std::string_view::npos)
+        return false;
+
+    name = line.substr(1, end - 1);
+    return true;
+}
+
+/// Offset of the #version directive in @p source, or npos if anything other than whitespace and comments precedes it.
+auto findVersion(std::string_view source) -> std::size_t
+{
+    std::size_t offset = 0;
+    while (offset < source.size())
+    {
+        const auto rest = source.substr(offset);
+        if (rest.front() == ' ' || rest.front() == '\t' || rest.front() == '\r' || rest.front() == '\n')
+        {
+            offset++;
+        }
+        else if (rest.substr(0, 2) == "//")
+        {
+            offset = source.find('\n', offset);
+        }
+        else if (rest.substr(0, 2) == "/*")
+        {
+            // block comments, such as license headers, may span lines
+            const auto end = source.find("*/", offset + 2);
+            if (end == std::string_view::npos)
+                return std::string_view::npos;
+            offset = end + 2;
+        }
+        else
+        {
+            const auto directive = trimLeft(rest.substr(1));
+            if (rest.front() != '#' || directive.substr(0, 7) != "version")
+                return std::string_view::npos;
+            return offset;
+        }
+    }
+    return std::string_view::npos;
+}
+
+/// Calls @p function for each line of @p source, without its line terminator, along with its 1-based number.
+template<class Function>
+void forEachLine(std::string_view source, Function &&function)
+{
+    std::size_t line_number = 1;
+    while (!source.empty())
+    {
+        const auto end = source.find('\n');
+        const auto line = source.substr(0, end);
+        function(line, line_number++);
+
+        if (end == std::string_view::npos)
+            break;
+        source.remove_prefix(end + 1);
+    }
+}
+
+} // namespace
+
+ShaderPreprocessor::ShaderPreprocessor(std::vector<std::string> include_directories)
+        : m_include_directories(std::move(include_directories))
+{}
+
+auto ShaderPreprocessor::expand(std::string_view source, const ShaderDefines &defines, const std::string &directory)
+-> Expansion
+{
+    Expansion expansion;
+
+    // the #version directive must come first; find the line after it, skipping whitespace and comments
+    std::size_t body_offset = 0;
+    std::size_t body_line = 1;
+    const auto version = findVersion(source);
+    if (version != std::string_view::npos)
+    {
+        const auto end = source.find('\n', version);
+        body_offset = end == std::string_view::npos ? source.size() : end + 1;
+        body_line = 2 + std::count(source.begin(), source.begin() + version, '\n');
+    }
+
+    expansion.source.append(source.substr(0, body_offset));
+    if (body_offset > 0 && expansion.source.back() != '\n')
+        expansion.source += '\n';
+
+    auto sorted_defines = defines;
+    std::sort(sorted_defines.begin(), sorted_defines.end());
+    for (const auto &[name, value]: sorted_defines)
+    {
+        expansion.source += "#define ";
+        expansion.source += name;
+        if (!value.empty())
+        {
+            expansion.source += ' ';
+            expansion.source += value;
+        }
+        expansion.source += '\n';
+    }
+
+    if (!sorted_defines.empty())
+        expansion.source += "#line " + std::to_string(body_line) + " 0\n";
+
+    append(source.substr(body_offset), 0, body_line, directory, expansion);
+
+    expansion.hash = hash(expansion.source);
+
+    // every included file was expanded once, so this replaces all of its edges from older expansions
+    for (const auto &dependency: expansion.dependencies)
+        m_includes[dependency].clear();
+    for (const auto &[including, included]: expansion.includes)
+    {
+        if (including > 0)
+            m_includes[expansion.dependencies[including - 1]].push_back(expansion.dependencies[included - 1]);
+    }
+
+    return expansion;
+}
+
+auto ShaderPreprocessor::expandFile(const std::string &path, const ShaderDefines &defines) -> Expansion
+{
+    const auto normal_path = std::filesystem::absolute(path).lexically_normal();
+    auto expansion = expand(load(normal_path.string()), defines, normal_path.parent_path().string());
+
+    auto &includes = m_includes[normal_path.string()];
+    includes.clear();
+    for (const auto &[including, included]: expansion.includes)
+    {
+        if (including == 0)
+            includes.push_back(expansion.dependencies[included - 1]);
+    }
+
+    return expansion;
+}
+
+auto ShaderPreprocessor::getDependents(const std::string &path) const -> std::vector<std::string>
+{
+    // walk the include edges backwards, from the file to everything that reaches it
+    std::vector<std::string> dependents;
+    std::vector<std::string> pending{std::filesystem::absolute(path).lexically_normal().string()};
+    while (!pending.empty())
+    {
+        const auto included = std::move(pending.back());
+        pending.pop_back();
+
+        for (const auto &[including, includes]: m_includes)
+        {
+            if (std::find(includes.begin(), includes.end(), included) == includes.end()
+                || std::find(dependents.begin(), dependents.end(), including) != dependents.end())
+            {
+                continue;
+            }
+
+            dependents.push_back(including);
+            pending.push_back(including);
+        }
+    }
+
+    std::sort(dependents.begin(), dependents.end());
+    return dependents;
+}
+
+void ShaderPreprocessor::invalidate(const std::string &path)
+{
+    if (path.empty())
+        m_files.clear();
+    else
+        m_files.erase(std::filesystem::absolute(path).lexically_normal().string());
+}
+
+auto ShaderPreprocessor::load(const std::string &path) -> const std::string &
+{
+    const auto iter = m_files.find(path);
+    if (iter != m_files.end())
+        return iter->second;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw Error("failed to read shader file " + path);
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    return m_files.emplace(path, contents.str()).first->second;
+}
+
+auto ShaderPreprocessor::resolve(std::string_view name, const std::string &directory) -> std::string
+{
+    const auto candidate = [&](const std::string &base)
+    {
+        return (std::filesystem::absolute(base) / name).lexically_normal().string();
+    };
+
+    auto path = candidate(directory);
+    if (m_files.count(path) || std::filesystem::exists(path))
+        return path;
+
+    for (const auto &include_directory: m_include_directories)
+    {
+        path = candidate(include_directory);
+        if (m_files.count(path) || std::filesystem::exists(path))
+            return path;
+    }
+
+    throw Error("shader include \"" + std::string(name) + "\" not found");
+}
+
+void ShaderPreprocessor::append(std::string_view source, std::size_t source_number, std::size_t first_line,
+                                const std::string &directory, Expansion &expansion)
+{
+    forEachLine(source, [&](std::string_view line, std::size_t line_number)
+    {
+        std::string_view name;
+        if (!parseInclude(line, name))
+        {
+            expansion.source.append(line);
+            expansion.source += '\n';
+            return;
+        }
+
+        const auto path = resolve(name, directory);
+        const auto next_line = std::to_string(first_line + line_number) + ' ' + std::to_string(source_number);
+
+        auto &dependencies = expansion.dependencies;
+        const auto iter = std::find(dependencies.begin(), dependencies.end(), path);
+        if (iter != dependencies.end())
+        {
+            // already included; keep the line count intact
+            expansion.includes.emplace_back(source_number, iter - dependencies.begin() + 1);
+            expansion.source += '\n';
+            return;
+        }
+
+        dependencies.push_back(path);
+        const auto include_number = dependencies.size();
+        expansion.includes.emplace_back(source_number, include_number);
+
+        expansion.source += "#line 1 " + std::to_string(include_number) + '\n';
+        append(load(path), include_number, 1, std::filesystem::path(path).parent_path().string(), expansion);
+        expansion.source += "#line " + next_line + '\n';
+    });
+}
+
+auto ShaderVariantCache::get(ShaderHandle::Type type, const std::string &path, const ShaderDefines &defines)
+-> ShaderHandle
+{
+    return get(type, m_preprocessor.expandFile(path, defines));
+}
+
+auto ShaderVariantCache::getFromSource(ShaderHandle::Type type, std::string_view source, const ShaderDefines &defines)
+-> ShaderHandle
+{
+    return get(type, m_preprocessor.expand(source, defines));
+}
+
+auto ShaderVariantCache::get(ShaderHandle::Type type, const ShaderPreprocessor::Expansion &expansion) -> ShaderHandle
+{
+    m_request_count++;
+
+    const auto key = hash(static_cast<std::uint64_t>(type), expansion.hash);
+
+    const auto iter = m_shaders.find(key);
+    if (iter != m_shaders.end())
+        return iter->second;
+
+    Shader shader(type);
+    shader.setSource(expansion.source);
+    shader.compile();
+
+    return m_shaders.emplace(key, std::move(shader)).first->second;
+}
+
+} // GL
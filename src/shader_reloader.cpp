@@ -0,0 +1,171 @@
+#include "glutils/shader_reloader.hpp"
+#include "glutils/error.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace GL {
+
+namespace {
+
+auto normalizePath(const std::string &path) -> std::filesystem::path
+{
+    return std::filesystem::absolute(path).lexically_normal();
+}
+
+bool readFile(const std::string &path, std::string &contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+}
+
+} // namespace
+
+ShaderReloader::ShaderReloader(std::vector<ProgramCompiler::MakeContextCurrent> worker_contexts)
+        : m_compiler(std::move(worker_contexts))
+{
+    m_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify_fd < 0)
+        throw Error("failed to initialize inotify");
+}
+
+ShaderReloader::~ShaderReloader()
+{
+    close(m_inotify_fd);
+}
+
+auto ShaderReloader::add(std::vector<ShaderFile> files) -> std::size_t
+{
+    const auto id = m_entries.size();
+
+    for (auto &file: files)
+    {
+        const auto path = normalizePath(file.path);
+        file.path = path.string();
+
+        // editors often save by replacing the file, so the directory is watched rather than the file itself
+        const auto directory = path.parent_path().string();
+        const int wd = inotify_add_watch(m_inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0)
+            throw Error("failed to watch directory " + directory);
+
+        m_watched_directories[wd] = directory;
+        m_file_entries[file.path].push_back(id);
+    }
+
+    m_entries.push_back(Entry{std::move(files)});
+    submit(id);
+
+    // only wait for this program; rebuilds of the others are swapped in and reported by update()
+    if (m_entries[id].pending)
+    {
+        std::vector<std::size_t> replaced;
+        complete({m_compiler.wait(m_entries[id].pending)}, replaced);
+    }
+
+    return id;
+}
+
+auto ShaderReloader::update() -> std::vector<std::size_t>
+{
+    readEvents();
+
+    std::vector<std::size_t> replaced;
+    complete(m_compiler.poll(), replaced);
+
+    // programs which changed again while being rebuilt, or for the first time
+    for (std::size_t id = 0; id < m_entries.size(); id++)
+        if (m_entries[id].changed && !m_entries[id].pending)
+            submit(id);
+
+    return replaced;
+}
+
+void ShaderReloader::submit(std::size_t id)
+{
+    auto &entry = m_entries[id];
+    entry.changed = false;
+
+    std::vector<std::string> contents(entry.files.size());
+    std::vector<ShaderSource> sources;
+
+    for (std::size_t i = 0; i < entry.files.size(); i++)
+    {
+        if (!readFile(entry.files[i].path, contents[i]))
+        {
+            entry.error = "failed to read " + entry.files[i].path;
+            return;
+        }
+        sources.push_back({entry.files[i].type, contents[i]});
+    }
+
+    entry.pending = ProgramHandle::create();
+    m_compiler.submit(entry.pending, sources);
+}
+
+void ShaderReloader::complete(const std::vector<ProgramCompiler::Result> &results, std::vector<std::size_t> &replaced)
+{
+    for (const auto &result: results)
+    {
+        const auto entry = std::find_if(m_entries.begin(), m_entries.end(),
+                                        [&](const Entry &e) { return e.pending == result.program; });
+        if (entry == m_entries.end())
+            continue;
+
+        if (result.linked)
+        {
+            entry->current = std::move(entry->pending);
+            entry->generation++;
+            entry->error.clear();
+            replaced.push_back(entry - m_entries.begin());
+        }
+        else
+        {
+            entry->pending = ProgramHandle();
+            entry->error = result.info_log;
+        }
+    }
+}
+
+void ShaderReloader::readEvents()
+{
+    alignas(inotify_event) char buffer[4096];
+
+    while (true)
+    {
+        const auto length = read(m_inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (ssize_t i = 0; i < length;)
+        {
+            const auto event = reinterpret_cast<const inotify_event *>(buffer + i);
+            i += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            const auto directory = m_watched_directories.find(event->wd);
+            if (directory == m_watched_directories.end() || event->len == 0)
+                continue;
+
+            const auto path = (std::filesystem::path(directory->second) / event->name).string();
+            const auto file = m_file_entries.find(path);
+            if (file == m_file_entries.end())
+                continue;
+
+            for (const auto id: file->second)
+                m_entries[id].changed = true;
+        }
+    }
+}
+
+} // GL
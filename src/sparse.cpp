@@ -0,0 +1,356 @@
+#include "glutils/sparse.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+
+namespace GL {
+
+namespace {
+
+// GL_ARB_sparse_texture
+constexpr GLenum texture_sparse = 0x91A6;
+constexpr GLenum virtual_page_size_index = 0x91A7;
+constexpr GLenum num_sparse_levels = 0x91AA;
+constexpr GLenum num_virtual_page_sizes = 0x91A8;
+constexpr GLenum virtual_page_size_x = 0x9195;
+constexpr GLenum virtual_page_size_y = 0x9196;
+constexpr GLenum virtual_page_size_z = 0x9197;
+
+// GL_ARB_sparse_buffer
+constexpr GLenum sparse_buffer_page_size = 0x82F8;
+
+// texture pages are keyed by level and page coordinates
+constexpr int page_bits_xy = 20;
+constexpr int page_bits_z = 16;
+
+auto getPageKey(GLint level, GLint x, GLint y, GLint z) -> std::uint64_t
+{
+    return std::uint64_t(level) << (2 * page_bits_xy + page_bits_z) | std::uint64_t(z) << (2 * page_bits_xy)
+           | std::uint64_t(y) << page_bits_xy | std::uint64_t(x);
+}
+
+auto getPageField(std::uint64_t key, int shift, int bits) -> GLint
+{
+    return static_cast<GLint>((key >> shift) & ((std::uint64_t(1) << bits) - 1));
+}
+
+} // namespace
+
+SparsePageTable::SparsePageTable(std::size_t budget, CommitFunction commit)
+        : m_budget(budget), m_commit(std::move(commit))
+{
+}
+
+bool SparsePageTable::request(std::uint64_t page)
+{
+    auto iter = m_pages.find(page);
+    if (iter != m_pages.end())
+    {
+        iter->second.last_frame = m_frame;
+        m_lru.splice(m_lru.begin(), m_lru, iter->second.lru);
+        return true;
+    }
+
+    // evict before committing, so the committed memory never exceeds the budget
+    while (m_pages.size() >= m_budget)
+    {
+        if (m_lru.empty())
+            return false;
+
+        auto victim = m_pages.find(m_lru.back());
+        if (victim->second.last_frame == m_frame)
+            return false;
+
+        decommit(victim);
+        m_eviction_count++;
+    }
+
+    m_commit(page, true);
+    m_lru.push_front(page);
+    m_pages.emplace(page, Page{m_lru.begin(), m_frame});
+    m_commit_count++;
+    return true;
+}
+
+void SparsePageTable::release(std::uint64_t page)
+{
+    auto iter = m_pages.find(page);
+    if (iter != m_pages.end())
+        decommit(iter);
+}
+
+void SparsePageTable::releaseAll()
+{
+    while (!m_lru.empty())
+        decommit(m_pages.find(m_lru.front()));
+}
+
+void SparsePageTable::decommit(std::unordered_map<std::uint64_t, Page>::iterator page)
+{
+    m_commit(page->first, false);
+    m_lru.erase(page->second.lru);
+    m_pages.erase(page);
+}
+
+struct SparseTexture::Procs
+{
+    // glTexturePageCommitmentEXT, with GL_EXT_direct_state_access
+    void (GLAD_API_PTR *texture_page_commitment)(GLuint texture, GLint level, GLint xoffset, GLint yoffset,
+                                                 GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                                 GLboolean commit);
+    // glTexPageCommitmentARB, which works on the texture bound to the active unit
+    void (GLAD_API_PTR *tex_page_commitment)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                                             GLsizei width, GLsizei height, GLsizei depth, GLboolean commit);
+};
+
+auto SparseTexture::queryPageSize(TextureHandle::Type type, TextureHandle::SizedInternalFormat internal_format)
+-> std::optional<PageSize>
+{
+    if (!getLimits().hasExtension("GL_ARB_sparse_texture"))
+        return std::nullopt;
+
+    const auto target = static_cast<GLenum>(type);
+    const auto format = static_cast<GLenum>(internal_format);
+
+    GLint count = 0;
+    glGetInternalformativ(target, format, num_virtual_page_sizes, 1, &count);
+    if (count <= 0)
+        return std::nullopt;
+
+    PageSize size;
+    glGetInternalformativ(target, format, virtual_page_size_x, 1, &size.x);
+    glGetInternalformativ(target, format, virtual_page_size_y, 1, &size.y);
+    glGetInternalformativ(target, format, virtual_page_size_z, 1, &size.z);
+    return size;
+}
+
+SparseTexture::SparseTexture(TextureHandle::Type type, TextureHandle::SizedInternalFormat internal_format,
+                             GLsizei levels, GLsizei width, GLsizei height, GLsizei depth, std::size_t page_budget,
+                             std::optional<PageSize> simulated_page_size)
+        : m_texture(type), m_type(type), m_levels(levels), m_width(width), m_height(height), m_depth(depth),
+          m_simulated(simulated_page_size.has_value()),
+          m_pages(page_budget, [this](std::uint64_t page, bool commit) { commitPage(page, commit); })
+{
+    if (type != TextureHandle::Type::_2d && type != TextureHandle::Type::_2d_array && type != TextureHandle::Type::_3d)
+        throw Error("sparse textures must be of type _2d, _2d_array or _3d");
+
+    if (m_simulated)
+    {
+        m_page_size = *simulated_page_size;
+        if (m_page_size.x <= 0 || m_page_size.y <= 0 || m_page_size.z <= 0)
+            throw Error("simulated sparse texture page size must be positive");
+
+        // like most implementations, only levels at least a page large are sparse
+        while (m_sparse_levels < levels)
+        {
+            const auto size = getLevelSize(m_sparse_levels);
+            if (size.x < m_page_size.x || size.y < m_page_size.y || size.z < m_page_size.z)
+                break;
+            m_sparse_levels++;
+        }
+        return;
+    }
+
+    const auto page_size = queryPageSize(type, internal_format);
+    if (!page_size)
+        throw Error("sparse textures of this type and format aren't supported");
+    m_page_size = *page_size;
+
+    m_procs = std::make_unique<Procs>();
+    if (getLimits().hasExtension("GL_EXT_direct_state_access"))
+    {
+        m_procs->texture_page_commitment = reinterpret_cast<decltype(Procs::texture_page_commitment)>(
+                getProcAddress("glTexturePageCommitmentEXT"));
+    }
+    m_procs->tex_page_commitment = reinterpret_cast<decltype(Procs::tex_page_commitment)>(
+            getProcAddress("glTexPageCommitmentARB"));
+
+    if (!m_procs->texture_page_commitment && !m_procs->tex_page_commitment)
+        throw Error("glTexPageCommitmentARB isn't available");
+
+    // the sparse flag must be set before the storage is allocated
+    const auto name = m_texture.getName();
+    glTextureParameteri(name, texture_sparse, GL_TRUE);
+    glTextureParameteri(name, virtual_page_size_index, 0);
+
+    if (type == TextureHandle::Type::_2d)
+        m_texture.setStorage2D(levels, internal_format, width, height);
+    else
+        m_texture.setStorage3D(levels, internal_format, width, height, depth);
+
+    glGetTextureParameteriv(name, num_sparse_levels, &m_sparse_levels);
+    m_sparse_levels = std::min(m_sparse_levels, levels);
+
+    for (GLint level = m_sparse_levels; level < levels; level++)
+    {
+        const auto size = getLevelSize(level);
+        commit(level, 0, 0, 0, size.x, size.y, size.z, true);
+    }
+}
+
+// deleting the texture releases its committed memory
+SparseTexture::~SparseTexture() = default;
+
+bool SparseTexture::request(GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth)
+{
+    // the mip tail is always committed
+    if (level < 0 || level >= m_sparse_levels)
+        return true;
+
+    // clip the region to the level, so an empty or outside region doesn't commit the pages at its corner
+    const auto size = getLevelSize(level);
+    const auto begin_x = std::max(x, 0);
+    const auto begin_y = std::max(y, 0);
+    const auto begin_z = std::max(z, 0);
+    const auto end_x = std::min(x + width, size.x);
+    const auto end_y = std::min(y + height, size.y);
+    const auto end_z = std::min(z + depth, size.z);
+    if (end_x <= begin_x || end_y <= begin_y || end_z <= begin_z)
+        return true;
+
+    const auto first_x = begin_x / m_page_size.x;
+    const auto first_y = begin_y / m_page_size.y;
+    const auto first_z = begin_z / m_page_size.z;
+    const auto last_x = (end_x - 1) / m_page_size.x;
+    const auto last_y = (end_y - 1) / m_page_size.y;
+    const auto last_z = (end_z - 1) / m_page_size.z;
+
+    bool committed = true;
+    for (GLint page_z = first_z; page_z <= last_z; page_z++)
+    {
+        for (GLint page_y = first_y; page_y <= last_y; page_y++)
+        {
+            for (GLint page_x = first_x; page_x <= last_x; page_x++)
+                committed = m_pages.request(getPageKey(level, page_x, page_y, page_z)) && committed;
+        }
+    }
+    return committed;
+}
+
+void SparseTexture::commit(GLint level, GLint x, GLint y, GLint z, GLsizei width, GLsizei height, GLsizei depth,
+                           bool commit)
+{
+    if (m_procs->texture_page_commitment)
+    {
+        m_procs->texture_page_commitment(m_texture.getName(), level, x, y, z, width, height, depth, commit);
+        return;
+    }
+
+    const auto target = static_cast<GLenum>(m_type);
+    const auto binding = m_type == TextureHandle::Type::_2d ? GL_TEXTURE_BINDING_2D
+                         : m_type == TextureHandle::Type::_2d_array ? GL_TEXTURE_BINDING_2D_ARRAY
+                         : GL_TEXTURE_BINDING_3D;
+
+    GLint previous = 0;
+    glGetIntegerv(binding, &previous);
+    glBindTexture(target, m_texture.getName());
+    m_procs->tex_page_commitment(target, level, x, y, z, width, height, depth, commit);
+    glBindTexture(target, static_cast<GLuint>(previous));
+}
+
+void SparseTexture::commitPage(std::uint64_t page, bool commit)
+{
+    if (m_simulated)
+        return;
+
+    const auto level = getPageField(page, 2 * page_bits_xy + page_bits_z, 8);
+    const auto x = getPageField(page, 0, page_bits_xy) * m_page_size.x;
+    const auto y = getPageField(page, page_bits_xy, page_bits_xy) * m_page_size.y;
+    const auto z = getPageField(page, 2 * page_bits_xy, page_bits_z) * m_page_size.z;
+
+    // regions must be multiples of the page size, or extend to the edge of the level
+    const auto size = getLevelSize(level);
+    this->commit(level, x, y, z, std::min(m_page_size.x, size.x - x), std::min(m_page_size.y, size.y - y),
+                 std::min(m_page_size.z, size.z - z), commit);
+}
+
+auto SparseTexture::getLevelSize(GLint level) const -> PageSize
+{
+    return {std::max(m_width >> level, 1),
+            std::max(m_height >> level, 1),
+            m_type == TextureHandle::Type::_3d ? std::max(m_depth >> level, 1) : m_depth};
+}
+
+struct SparseBuffer::Procs
+{
+    void (GLAD_API_PTR *named_buffer_page_commitment)(GLuint buffer, GLintptr offset, GLsizeiptr size,
+                                                      GLboolean commit);
+};
+
+auto SparseBuffer::queryPageSize() -> std::optional<GLsizeiptr>
+{
+    if (!getLimits().hasExtension("GL_ARB_sparse_buffer"))
+        return std::nullopt;
+
+    GLint size = 0;
+    glGetIntegerv(sparse_buffer_page_size, &size);
+    if (size <= 0)
+        return std::nullopt;
+    return size;
+}
+
+SparseBuffer::SparseBuffer(GLsizeiptr size, std::size_t page_budget, std::optional<GLsizeiptr> simulated_page_size)
+        : m_buffer(), m_size(size), m_page_size(simulated_page_size.value_or(0)),
+          m_simulated(simulated_page_size.has_value()),
+          m_pages(page_budget, [this](std::uint64_t page, bool commit) { commitPage(page, commit); })
+{
+    if (m_simulated)
+    {
+        if (m_page_size <= 0)
+            throw Error("simulated sparse buffer page size must be positive");
+        return;
+    }
+
+    const auto page_size = queryPageSize();
+    if (!page_size)
+        throw Error("sparse buffers aren't supported");
+    m_page_size = *page_size;
+
+    m_procs = std::make_unique<Procs>();
+    m_procs->named_buffer_page_commitment = reinterpret_cast<decltype(Procs::named_buffer_page_commitment)>(
+            getProcAddress("glNamedBufferPageCommitmentARB"));
+    if (!m_procs->named_buffer_page_commitment)
+    {
+        m_procs->named_buffer_page_commitment = reinterpret_cast<decltype(Procs::named_buffer_page_commitment)>(
+                getProcAddress("glNamedBufferPageCommitmentEXT"));
+    }
+    if (!m_procs->named_buffer_page_commitment)
+        throw Error("glNamedBufferPageCommitmentARB isn't available");
+
+    m_buffer.allocateImmutable(size, BufferHandle::StorageFlags::sparse_storage
+                                     | BufferHandle::StorageFlags::dynamic_storage);
+}
+
+// deleting the buffer releases its committed memory
+SparseBuffer::~SparseBuffer() = default;
+
+bool SparseBuffer::request(GLintptr offset, GLsizeiptr size)
+{
+    // clip the range to the buffer, so an empty or outside range doesn't commit the page at its start
+    const auto begin = std::max<GLintptr>(offset, 0);
+    const auto end = std::min(offset + size, m_size);
+    if (end <= begin)
+        return true;
+
+    const auto first = begin / m_page_size;
+    const auto last = (end - 1) / m_page_size;
+
+    bool committed = true;
+    for (auto page = first; page <= last; page++)
+        committed = m_pages.request(static_cast<std::uint64_t>(page)) && committed;
+    return committed;
+}
+
+void SparseBuffer::commitPage(std::uint64_t page, bool commit)
+{
+    if (m_simulated)
+        return;
+
+    // the last page may extend past the end of the buffer
+    const auto offset = static_cast<GLintptr>(page) * m_page_size;
+    m_procs->named_buffer_page_commitment(m_buffer.getName(), offset, std::min(m_page_size, m_size - offset), commit);
+}
+
+} // GL
@@ -0,0 +1,112 @@
+#include "glutils/streamed_texture.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+
+namespace GL {
+
+StreamedTexture::StreamedTexture(const std::string &path)
+        : m_file(path), m_container(m_file.data(), m_file.size()), m_texture(m_container.getType()),
+          m_base_level(m_container.getLevels())
+{
+    const auto levels = m_container.getLevels();
+    const auto format = m_container.getFormat();
+
+    if (m_container.getType() == TextureHandle::Type::_2d || m_container.getType() == TextureHandle::Type::cube_map)
+    {
+        m_texture.setStorage2D(levels, format, m_container.getWidth(), m_container.getHeight());
+    }
+    else
+    {
+        m_texture.setStorage3D(levels, format, m_container.getWidth(), m_container.getHeight(),
+                               m_container.getDepth());
+    }
+
+    // nothing may be sampled until the smallest level is uploaded
+    glTextureParameteri(m_texture.getName(), GL_TEXTURE_BASE_LEVEL, levels - 1);
+
+    for (const auto &image: m_container.getImages())
+        m_total_size += image.size;
+}
+
+bool StreamedTexture::stream(std::size_t budget)
+{
+    const auto &images = m_container.getImages();
+    if (m_next_image == images.size())
+        return true;
+
+    GLint alignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    // rows in the file are tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    const GLsizei block_height = m_container.isCompressed() ? 4 : 1;
+    std::size_t uploaded = 0;
+
+    while (m_next_image < images.size())
+    {
+        const auto &image = images[m_next_image];
+        const auto row_size = m_container.getRowSize(image.width);
+        const auto rows = (image.height + block_height - 1) / block_height;
+
+        const auto remaining = budget > uploaded ? budget - uploaded : 0;
+        auto strip_rows = static_cast<GLsizei>(std::min<std::size_t>(remaining / row_size, rows - m_next_row));
+        if (strip_rows == 0)
+        {
+            if (uploaded > 0)
+                break;
+            strip_rows = 1;
+        }
+
+        const auto y = m_next_row * block_height;
+        const auto height = std::min(strip_rows * block_height, image.height - y);
+        const auto size = row_size * strip_rows;
+        upload(image, y, height, image.data + row_size * m_next_row, size);
+
+        uploaded += size;
+        m_next_row += strip_rows;
+        if (m_next_row < rows)
+            continue;
+
+        m_next_row = 0;
+        m_next_image++;
+
+        // a level is complete once the next image belongs to a finer one
+        if (m_next_image == images.size() || images[m_next_image].level != image.level)
+        {
+            m_base_level = image.level;
+            glTextureParameteri(m_texture.getName(), GL_TEXTURE_BASE_LEVEL, m_base_level);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+
+    m_uploaded_size += uploaded;
+    return isComplete();
+}
+
+void StreamedTexture::upload(const TextureContainer::Image &image, GLint y, GLsizei height, const unsigned char *data,
+                             std::size_t size) const
+{
+    const auto format = m_container.getFormat();
+
+    if (m_container.getType() == TextureHandle::Type::_2d)
+    {
+        if (m_container.isCompressed())
+            m_texture.updateCompressedImage2D(image.level, 0, y, image.width, height, format, GLsizei(size), data);
+        else
+            m_texture.updateImage2D(image.level, 0, y, image.width, height, m_container.getDataFormat(),
+                                    m_container.getDataType(), data);
+        return;
+    }
+
+    // layers, cube map faces and slices are all addressed by z
+    if (m_container.isCompressed())
+        m_texture.updateCompressedImage3D(image.level, 0, y, image.z, image.width, height, 1, format, GLsizei(size),
+                                          data);
+    else
+        m_texture.updateImage3D(image.level, 0, y, image.z, image.width, height, 1, m_container.getDataFormat(),
+                                m_container.getDataType(), data);
+}
+
+} // GL
@@ -2,8 +2,36 @@
 
 #include "glutils/gl.hpp"
 
+#include <cstdint>
+
 namespace GL {
 
+namespace {
+
+// number of dimensions of the images of @p type, counting layers and faces as one
+auto getDimensions(TextureHandle::Type type) -> int
+{
+    switch (type)
+    {
+        case TextureHandle::Type::_1d:
+            return 1;
+        case TextureHandle::Type::_2d:
+        case TextureHandle::Type::_1d_array:
+        case TextureHandle::Type::rectangle:
+            return 2;
+        default:
+            return 3;
+    }
+}
+
+auto offsetPointer(const void *data, std::size_t offset) -> const void *
+{
+    // data may be an offset into a pixel unpack buffer rather than a valid pointer
+    return reinterpret_cast<const void *>(reinterpret_cast<std::uintptr_t>(data) + offset);
+}
+
+} // namespace
+
 TextureHandle TextureHandle::create(Type type)
 {
     TextureHandle new_handle;
@@ -16,6 +44,11 @@ void TextureHandle::destroy(TextureHandle handle)
     glDeleteTextures(1, &handle.m_name);
 }
 
+void TextureHandle::setStorage1D(GLsizei levels, SizedInternalFormat internal_format, GLsizei width) const
+{
+    glTextureStorage1D(m_name, levels, GLenum(internal_format), width);
+}
+
 void
 TextureHandle::setStorage2D(GLsizei levels, TextureHandle::SizedInternalFormat internal_format, GLsizei width,
                             GLsizei height)
@@ -24,6 +57,31 @@ const
     glTextureStorage2D(m_name, levels, GLenum(internal_format), width, height);
 }
 
+void TextureHandle::setStorage3D(GLsizei levels, SizedInternalFormat internal_format, GLsizei width, GLsizei height,
+                                 GLsizei depth) const
+{
+    glTextureStorage3D(m_name, levels, GLenum(internal_format), width, height, depth);
+}
+
+void TextureHandle::setStorage2DMultisample(GLsizei samples, SizedInternalFormat internal_format, GLsizei width,
+                                            GLsizei height, bool fixed_sample_locations) const
+{
+    glTextureStorage2DMultisample(m_name, samples, GLenum(internal_format), width, height, fixed_sample_locations);
+}
+
+void TextureHandle::setStorage3DMultisample(GLsizei samples, SizedInternalFormat internal_format, GLsizei width,
+                                            GLsizei height, GLsizei depth, bool fixed_sample_locations) const
+{
+    glTextureStorage3DMultisample(m_name, samples, GLenum(internal_format), width, height, depth,
+                                  fixed_sample_locations);
+}
+
+void TextureHandle::updateImage1D(GLint level, GLint xoffset, GLsizei width, DataFormat format, DataType type,
+                                  const void *pixel_data) const
+{
+    glTextureSubImage1D(m_name, level, xoffset, width, GLenum(format), GLenum(type), pixel_data);
+}
+
 void
 TextureHandle::updateImage2D(GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                              DataFormat format,
@@ -32,6 +90,160 @@ TextureHandle::updateImage2D(GLint level, GLint xoffset, GLint yoffset, GLsizei
     glTextureSubImage2D(m_name, level, xoffset, yoffset, width, height, GLenum(format), GLenum(type), pixel_data);
 }
 
+void
+TextureHandle::updateCompressedImage2D(GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+                                       SizedInternalFormat format, GLsizei image_size, const void *data) const
+{
+    glCompressedTextureSubImage2D(m_name, level, xoffset, yoffset, width, height, GLenum(format), image_size, data);
+}
+
+void TextureHandle::updateImage3D(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                                  GLsizei height, GLsizei depth, DataFormat format, DataType type,
+                                  const void *pixel_data) const
+{
+    glTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset, width, height, depth, GLenum(format), GLenum(type),
+                        pixel_data);
+}
+
+void TextureHandle::updateCompressedImage3D(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                                            GLsizei height, GLsizei depth, SizedInternalFormat format,
+                                            GLsizei image_size, const void *data) const
+{
+    glCompressedTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset, width, height, depth, GLenum(format),
+                                  image_size, data);
+}
+
+void TextureHandle::getSubImage(GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width,
+                                GLsizei height, GLsizei depth, DataFormat format, DataType type, GLsizei buffer_size,
+                                void *pixels) const
+{
+    glGetTextureSubImage(m_name, level, xoffset, yoffset, zoffset, width, height, depth, GLenum(format), GLenum(type),
+                         buffer_size, pixels);
+}
+
+void TextureHandle::updateLevel(Type type, const Level &level, DataFormat format, DataType data_type,
+                                const void *data) const
+{
+    const auto pixels = offsetPointer(data, level.offset);
+    switch (getDimensions(type))
+    {
+        case 1:
+            updateImage1D(level.level, 0, level.width, format, data_type, pixels);
+            break;
+        case 2:
+            updateImage2D(level.level, 0, 0, level.width, level.height, format, data_type, pixels);
+            break;
+        default:
+            updateImage3D(level.level, 0, 0, 0, level.width, level.height, level.depth, format, data_type, pixels);
+            break;
+    }
+}
+
+void TextureHandle::updateCompressedLevel(Type type, const Level &level, SizedInternalFormat format,
+                                          const void *data) const
+{
+    const auto blocks = offsetPointer(data, level.offset);
+    if (getDimensions(type) == 3)
+        updateCompressedImage3D(level.level, 0, 0, 0, level.width, level.height, level.depth, format, level.size,
+                                blocks);
+    else
+        updateCompressedImage2D(level.level, 0, 0, level.width, level.height, format, level.size, blocks);
+}
+
+auto TextureHandle::getBlockSize(SizedInternalFormat internal_format) -> GLsizei
+{
+    switch (internal_format)
+    {
+        case SizedInternalFormat::compressed_red_rgtc1:
+        case SizedInternalFormat::compressed_signed_red_rgtc1:
+        case SizedInternalFormat::compressed_rgb8_etc2:
+        case SizedInternalFormat::compressed_srgb8_etc2:
+        case SizedInternalFormat::compressed_rgb8_punchthrough_alpha1_etc2:
+        case SizedInternalFormat::compressed_srgb8_punchthrough_alpha1_etc2:
+        case SizedInternalFormat::compressed_r11_eac:
+        case SizedInternalFormat::compressed_signed_r11_eac:
+        case SizedInternalFormat::compressed_rgb_s3tc_dxt1:
+        case SizedInternalFormat::compressed_rgba_s3tc_dxt1:
+        case SizedInternalFormat::compressed_srgb_s3tc_dxt1:
+        case SizedInternalFormat::compressed_srgb_alpha_s3tc_dxt1:
+            return 8;
+        case SizedInternalFormat::compressed_rg_rgtc2:
+        case SizedInternalFormat::compressed_signed_rg_rgtc2:
+        case SizedInternalFormat::compressed_rgba_bptc_unorm:
+        case SizedInternalFormat::compressed_srgb_alpha_bptc_unorm:
+        case SizedInternalFormat::compressed_rgb_bptc_signed_float:
+        case SizedInternalFormat::compressed_rgb_bptc_unsigned_float:
+        case SizedInternalFormat::compressed_rgba8_etc2_eac:
+        case SizedInternalFormat::compressed_srgb8_alpha8_etc2_eac:
+        case SizedInternalFormat::compressed_rg11_eac:
+        case SizedInternalFormat::compressed_signed_rg11_eac:
+        case SizedInternalFormat::compressed_rgba_s3tc_dxt3:
+        case SizedInternalFormat::compressed_rgba_s3tc_dxt5:
+        case SizedInternalFormat::compressed_srgb_alpha_s3tc_dxt3:
+        case SizedInternalFormat::compressed_srgb_alpha_s3tc_dxt5:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+auto TextureHandle::getPixelSize(DataFormat format, DataType type) -> GLsizei
+{
+    switch (type)
+    {
+        case DataType::ubyte_3_3_2:
+        case DataType::ubyte_2_3_3_rev:
+            return 1;
+        case DataType::ushort_5_6_5:
+        case DataType::ushort_5_6_5_rev:
+        case DataType::ushort_4_4_4_4:
+        case DataType::ushort_4_4_4_4_rev:
+        case DataType::ushort_5_5_5_1:
+        case DataType::ushort_1_5_5_5_rev:
+            return 2;
+        case DataType::uint_8_8_8_8:
+        case DataType::uint_8_8_8_8_rev:
+        case DataType::uint_10_10_10_2:
+        case DataType::uint_2_10_10_10_rev:
+            return 4;
+        default:
+            break;
+    }
+
+    GLsizei component_count = 4;
+    switch (format)
+    {
+        case DataFormat::red:
+        case DataFormat::depth_component:
+        case DataFormat::stencil_index:
+            component_count = 1;
+            break;
+        case DataFormat::rg:
+            component_count = 2;
+            break;
+        case DataFormat::rgb:
+        case DataFormat::bgr:
+            component_count = 3;
+            break;
+        case DataFormat::rgba:
+        case DataFormat::bgra:
+            break;
+    }
+
+    switch (type)
+    {
+        case DataType::ubyte:
+        case DataType::_byte:
+            return component_count;
+        case DataType::ushort:
+        case DataType::_short:
+        case DataType::half_float:
+            return component_count * 2;
+        default:
+            return component_count * 4;
+    }
+}
+
 void TextureHandle::generateMipmap() const
 {
     glGenerateTextureMipmap(m_name);
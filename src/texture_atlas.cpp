@@ -0,0 +1,193 @@
+#include "glutils/texture_atlas.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace GL {
+
+AtlasPacker::AtlasPacker(GLsizei width, GLsizei height, GLsizei layers, GLsizei padding, GLsizei alignment)
+        : m_width(width), m_height(height), m_layers(layers), m_padding(padding), m_alignment(std::max(alignment, 1)),
+          m_rect_counts(std::size_t(std::max(layers, 0)), 0)
+{
+    for (GLint layer = 0; layer < layers; layer++)
+        m_free.push_back({layer, 0, 0, width, height});
+}
+
+auto AtlasPacker::insert(GLsizei width, GLsizei height) -> std::optional<Rect>
+{
+    const auto cell_width = getCellSize(width);
+    const auto cell_height = getCellSize(height);
+
+    auto best = m_free.end();
+    auto best_waste = std::numeric_limits<std::int64_t>::max();
+
+    for (auto iter = m_free.begin(); iter != m_free.end(); ++iter)
+    {
+        if (iter->width < cell_width || iter->height < cell_height)
+            continue;
+
+        const auto waste = std::int64_t(iter->width) * iter->height - std::int64_t(cell_width) * cell_height;
+        if (waste < best_waste || (waste == best_waste && iter->layer < best->layer))
+        {
+            best = iter;
+            best_waste = waste;
+        }
+    }
+
+    if (best == m_free.end())
+        return std::nullopt;
+
+    const auto free = *best;
+    m_free.erase(best);
+
+    // split along the shorter remaining side, which keeps the larger piece as large as possible
+    const auto remaining_width = free.width - cell_width;
+    const auto remaining_height = free.height - cell_height;
+
+    if (remaining_width < remaining_height)
+    {
+        addFree({free.layer, free.x + cell_width, free.y, remaining_width, cell_height});
+        addFree({free.layer, free.x, free.y + cell_height, free.width, remaining_height});
+    }
+    else
+    {
+        addFree({free.layer, free.x + cell_width, free.y, remaining_width, free.height});
+        addFree({free.layer, free.x, free.y + cell_height, cell_width, remaining_height});
+    }
+
+    m_rect_counts[free.layer]++;
+
+    return Rect{free.layer, free.x + m_padding, free.y + m_padding, width, height};
+}
+
+void AtlasPacker::remove(const Rect &rect)
+{
+    // Edge merging can't undo every split: a guillotine cut next to an L-shaped free region leaves pieces no
+    // neighbour shares a whole edge with. Once a layer is empty, its free space is simply one rectangle again.
+    if (--m_rect_counts[rect.layer] == 0)
+    {
+        m_free.erase(std::remove_if(m_free.begin(), m_free.end(), [&](const Rect &free)
+        { return free.layer == rect.layer; }), m_free.end());
+        m_free.push_back({rect.layer, 0, 0, m_width, m_height});
+        return;
+    }
+
+    Rect cell{rect.layer, rect.x - m_padding, rect.y - m_padding, getCellSize(rect.width), getCellSize(rect.height)};
+
+    // merge with free neighbours until none shares a whole edge with the cell
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+
+        for (auto iter = m_free.begin(); iter != m_free.end(); ++iter)
+        {
+            const auto &other = *iter;
+            if (other.layer != cell.layer)
+                continue;
+
+            if (other.x == cell.x && other.width == cell.width)
+            {
+                if (other.y + other.height == cell.y)
+                    cell = {cell.layer, cell.x, other.y, cell.width, cell.height + other.height};
+                else if (cell.y + cell.height == other.y)
+                    cell.height += other.height;
+                else
+                    continue;
+            }
+            else if (other.y == cell.y && other.height == cell.height)
+            {
+                if (other.x + other.width == cell.x)
+                    cell = {cell.layer, other.x, cell.y, cell.width + other.width, cell.height};
+                else if (cell.x + cell.width == other.x)
+                    cell.width += other.width;
+                else
+                    continue;
+            }
+            else
+            {
+                continue;
+            }
+
+            m_free.erase(iter);
+            merged = true;
+            break;
+        }
+    }
+
+    m_free.push_back(cell);
+}
+
+auto AtlasPacker::getFreeArea() const -> std::int64_t
+{
+    std::int64_t area = 0;
+    for (const auto &rect: m_free)
+        area += std::int64_t(rect.width) * rect.height;
+    return area;
+}
+
+auto AtlasPacker::getCellSize(GLsizei size) const -> GLsizei
+{
+    return (size + 2 * m_padding + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+void AtlasPacker::addFree(Rect rect)
+{
+    if (rect.width > 0 && rect.height > 0)
+        m_free.push_back(rect);
+}
+
+TextureAtlas::TextureAtlas(TextureHandle::SizedInternalFormat internal_format, GLsizei width, GLsizei height,
+                           GLsizei layers, GLsizei levels, GLsizei padding)
+        : m_texture(TextureHandle::Type::_2d_array),
+          m_packer(width, height, layers, padding << (std::max(levels, 1) - 1), 1 << (std::max(levels, 1) - 1))
+{
+    m_texture.setStorage3D(levels, internal_format, width, height, layers);
+}
+
+auto TextureAtlas::add(GLsizei width, GLsizei height, TextureHandle::DataFormat format,
+                       TextureHandle::DataType type, const void *pixels) -> std::optional<Entry>
+{
+    const auto rect = m_packer.insert(width, height);
+    if (!rect)
+        return std::nullopt;
+
+    // copy the image into the middle of a padded one, repeating its edge texels outwards
+    const auto padding = m_packer.getPadding();
+    const auto pixel_size = static_cast<std::size_t>(TextureHandle::getPixelSize(format, type));
+    const auto padded_width = width + 2 * padding;
+    const auto padded_height = height + 2 * padding;
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    const auto row_size = (padded_width * pixel_size + alignment - 1) / alignment * alignment;
+    const auto source = static_cast<const std::uint8_t *>(pixels);
+
+    m_staging.resize(row_size * padded_height);
+
+    for (GLsizei y = 0; y < padded_height; y++)
+    {
+        const auto source_row = source + std::clamp(y - padding, 0, height - 1) * width * pixel_size;
+        auto row = m_staging.data() + y * row_size;
+
+        for (GLsizei x = 0; x < padding; x++)
+            std::memcpy(row + x * pixel_size, source_row, pixel_size);
+
+        std::memcpy(row + padding * pixel_size, source_row, width * pixel_size);
+
+        for (GLsizei x = padding + width; x < padded_width; x++)
+            std::memcpy(row + x * pixel_size, source_row + (width - 1) * pixel_size, pixel_size);
+    }
+
+    m_texture.updateImage3D(0, rect->x - padding, rect->y - padding, rect->layer, padded_width, padded_height, 1,
+                            format, type, m_staging.data());
+
+    const auto atlas_width = static_cast<float>(m_packer.getWidth());
+    const auto atlas_height = static_cast<float>(m_packer.getHeight());
+    return Entry{*rect,
+                 glm::vec2{float(rect->x) / atlas_width, float(rect->y) / atlas_height},
+                 glm::vec2{float(rect->x + width) / atlas_width, float(rect->y + height) / atlas_height}};
+}
+
+} // GL
@@ -0,0 +1,185 @@
+#include "glutils/texture_binding_tracker.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+#include "glutils/limits.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace GL {
+
+bool TextureBindingTracker::ImageUnit::operator==(const ImageUnit &other) const
+{
+    if (texture != other.texture || whole != other.whole)
+        return false;
+    return whole || (level == other.level && layer == other.layer && access == other.access && format == other.format);
+}
+
+TextureBindingTracker::TextureBindingTracker()
+        : m_textures(static_cast<std::size_t>(getLimits().max_combined_texture_image_units)),
+          m_bound_textures(m_textures.size(), {s_unknown, s_unknown}),
+          m_textures_touched(m_textures.size(), 0),
+          m_textures_begin(static_cast<GLuint>(m_textures.size())),
+          m_images(static_cast<std::size_t>(getLimits().max_image_units)),
+          m_bound_images(m_images.size(), ImageUnit{s_unknown}),
+          m_images_touched(m_images.size(), 0),
+          m_images_begin(static_cast<GLuint>(m_images.size()))
+{
+}
+
+void TextureBindingTracker::setTexture(GLuint unit, TextureHandle texture, SamplerHandle sampler)
+{
+    touchTexture(unit);
+    m_textures[unit] = {texture.getName(), sampler.getName()};
+}
+
+void TextureBindingTracker::setImage(GLuint unit, TextureHandle texture)
+{
+    touchImage(unit);
+    m_images[unit] = {texture.getName()};
+}
+
+void TextureBindingTracker::setImage(GLuint unit, TextureHandle texture, GLint level, GLint layer,
+                                     ImageAccess access, TextureHandle::SizedInternalFormat format)
+{
+    touchImage(unit);
+    m_images[unit] = {texture.getName(), level, layer, access, format, false};
+}
+
+void TextureBindingTracker::flush()
+{
+    flushTextures();
+    flushImages();
+}
+
+void TextureBindingTracker::invalidate()
+{
+    std::fill(m_bound_textures.begin(), m_bound_textures.end(), TextureUnit{s_unknown, s_unknown});
+    std::fill(m_bound_images.begin(), m_bound_images.end(), ImageUnit{s_unknown});
+}
+
+void TextureBindingTracker::flushTextures()
+{
+    if (m_textures_begin >= m_textures_end)
+        return;
+
+    // textures first, then samplers: each run of consecutive units whose name changed is bound with one call
+    for (const bool samplers: {false, true})
+    {
+        auto name_of = [samplers](const TextureUnit &unit) { return samplers ? unit.sampler : unit.texture; };
+
+        GLuint unit = m_textures_begin;
+        while (unit < m_textures_end)
+        {
+            if (!m_textures_touched[unit] || name_of(m_textures[unit]) == name_of(m_bound_textures[unit]))
+            {
+                unit++;
+                continue;
+            }
+
+            const auto first = unit;
+            m_names.clear();
+            while (unit < m_textures_end && m_textures_touched[unit]
+                   && name_of(m_textures[unit]) != name_of(m_bound_textures[unit]))
+            {
+                m_names.push_back(name_of(m_textures[unit]));
+                unit++;
+            }
+
+            if (samplers)
+                glBindSamplers(first, GLsizei(m_names.size()), m_names.data());
+            else
+                glBindTextures(first, GLsizei(m_names.size()), m_names.data());
+            m_issued_count++;
+        }
+    }
+
+    for (GLuint unit = m_textures_begin; unit < m_textures_end; unit++)
+    {
+        if (!m_textures_touched[unit])
+            continue;
+
+        const auto &bound = m_bound_textures[unit];
+        if (m_textures[unit].texture == bound.texture && m_textures[unit].sampler == bound.sampler)
+            m_elided_count++;
+
+        m_bound_textures[unit] = m_textures[unit];
+        m_textures_touched[unit] = 0;
+    }
+
+    m_textures_begin = static_cast<GLuint>(m_textures.size());
+    m_textures_end = 0;
+}
+
+void TextureBindingTracker::flushImages()
+{
+    if (m_images_begin >= m_images_end)
+        return;
+
+    GLuint unit = m_images_begin;
+    while (unit < m_images_end)
+    {
+        const auto &image = m_images[unit];
+        if (!m_images_touched[unit] || image == m_bound_images[unit])
+        {
+            m_elided_count += m_images_touched[unit] ? 1 : 0;
+            unit++;
+            continue;
+        }
+
+        if (!image.whole)
+        {
+            glBindImageTexture(unit, image.texture, image.level, image.layer < 0, std::max(image.layer, 0),
+                               static_cast<GLenum>(image.access), static_cast<GLenum>(image.format));
+            m_issued_count++;
+            unit++;
+            continue;
+        }
+
+        const auto first = unit;
+        m_names.clear();
+        while (unit < m_images_end && m_images_touched[unit] && m_images[unit].whole
+               && !(m_images[unit] == m_bound_images[unit]))
+        {
+            m_names.push_back(m_images[unit].texture);
+            unit++;
+        }
+
+        glBindImageTextures(first, GLsizei(m_names.size()), m_names.data());
+        m_issued_count++;
+    }
+
+    for (GLuint image_unit = m_images_begin; image_unit < m_images_end; image_unit++)
+    {
+        if (!m_images_touched[image_unit])
+            continue;
+
+        m_bound_images[image_unit] = m_images[image_unit];
+        m_images_touched[image_unit] = 0;
+    }
+
+    m_images_begin = static_cast<GLuint>(m_images.size());
+    m_images_end = 0;
+}
+
+void TextureBindingTracker::touchTexture(GLuint unit)
+{
+    if (unit >= m_textures.size())
+        throw Error("texture unit " + std::to_string(unit) + " is out of range");
+
+    m_textures_touched[unit] = 1;
+    m_textures_begin = std::min(m_textures_begin, unit);
+    m_textures_end = std::max(m_textures_end, unit + 1);
+}
+
+void TextureBindingTracker::touchImage(GLuint unit)
+{
+    if (unit >= m_images.size())
+        throw Error("image unit " + std::to_string(unit) + " is out of range");
+
+    m_images_touched[unit] = 1;
+    m_images_begin = std::min(m_images_begin, unit);
+    m_images_end = std::max(m_images_end, unit + 1);
+}
+
+} // GL
@@ -0,0 +1,400 @@
+#include "glutils/texture_container.hpp"
+#include "glutils/error.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace GL {
+
+namespace {
+
+using Format = TextureHandle::SizedInternalFormat;
+using DataFormat = TextureHandle::DataFormat;
+using DataType = TextureHandle::DataType;
+
+struct FormatInfo
+{
+    std::uint32_t code{0};
+    Format format{Format::rgba8};
+    // only used by uncompressed formats
+    DataFormat data_format{DataFormat::rgba};
+    DataType data_type{DataType::ubyte};
+};
+
+// VkFormat values used by KTX2
+constexpr FormatInfo vk_formats[] = {
+        {9, Format::r8, DataFormat::red, DataType::ubyte},
+        {16, Format::rg8, DataFormat::rg, DataType::ubyte},
+        {37, Format::rgba8, DataFormat::rgba, DataType::ubyte},
+        {43, Format::srgb8_alpha8, DataFormat::rgba, DataType::ubyte},
+        {44, Format::rgba8, DataFormat::bgra, DataType::ubyte},
+        {50, Format::srgb8_alpha8, DataFormat::bgra, DataType::ubyte},
+        {76, Format::r16f, DataFormat::red, DataType::half_float},
+        {83, Format::rg16f, DataFormat::rg, DataType::half_float},
+        {97, Format::rgba16f, DataFormat::rgba, DataType::half_float},
+        {100, Format::r32f, DataFormat::red, DataType::_float},
+        {103, Format::rg32f, DataFormat::rg, DataType::_float},
+        {109, Format::rgba32f, DataFormat::rgba, DataType::_float},
+        {131, Format::compressed_rgb_s3tc_dxt1},
+        {132, Format::compressed_srgb_s3tc_dxt1},
+        {133, Format::compressed_rgba_s3tc_dxt1},
+        {134, Format::compressed_srgb_alpha_s3tc_dxt1},
+        {135, Format::compressed_rgba_s3tc_dxt3},
+        {136, Format::compressed_srgb_alpha_s3tc_dxt3},
+        {137, Format::compressed_rgba_s3tc_dxt5},
+        {138, Format::compressed_srgb_alpha_s3tc_dxt5},
+        {139, Format::compressed_red_rgtc1},
+        {140, Format::compressed_signed_red_rgtc1},
+        {141, Format::compressed_rg_rgtc2},
+        {142, Format::compressed_signed_rg_rgtc2},
+        {143, Format::compressed_rgb_bptc_unsigned_float},
+        {144, Format::compressed_rgb_bptc_signed_float},
+        {145, Format::compressed_rgba_bptc_unorm},
+        {146, Format::compressed_srgb_alpha_bptc_unorm},
+        {147, Format::compressed_rgb8_etc2},
+        {148, Format::compressed_srgb8_etc2},
+        {149, Format::compressed_rgb8_punchthrough_alpha1_etc2},
+        {150, Format::compressed_srgb8_punchthrough_alpha1_etc2},
+        {151, Format::compressed_rgba8_etc2_eac},
+        {152, Format::compressed_srgb8_alpha8_etc2_eac},
+        {153, Format::compressed_r11_eac},
+        {154, Format::compressed_signed_r11_eac},
+        {155, Format::compressed_rg11_eac},
+        {156, Format::compressed_signed_rg11_eac},
+};
+
+// DXGI_FORMAT values used by DDS files with a DX10 header
+constexpr FormatInfo dxgi_formats[] = {
+        {2, Format::rgba32f, DataFormat::rgba, DataType::_float},
+        {10, Format::rgba16f, DataFormat::rgba, DataType::half_float},
+        {16, Format::rg32f, DataFormat::rg, DataType::_float},
+        {28, Format::rgba8, DataFormat::rgba, DataType::ubyte},
+        {29, Format::srgb8_alpha8, DataFormat::rgba, DataType::ubyte},
+        {34, Format::rg16f, DataFormat::rg, DataType::half_float},
+        {41, Format::r32f, DataFormat::red, DataType::_float},
+        {49, Format::rg8, DataFormat::rg, DataType::ubyte},
+        {54, Format::r16f, DataFormat::red, DataType::half_float},
+        {61, Format::r8, DataFormat::red, DataType::ubyte},
+        {71, Format::compressed_rgba_s3tc_dxt1},
+        {72, Format::compressed_srgb_alpha_s3tc_dxt1},
+        {74, Format::compressed_rgba_s3tc_dxt3},
+        {75, Format::compressed_srgb_alpha_s3tc_dxt3},
+        {77, Format::compressed_rgba_s3tc_dxt5},
+        {78, Format::compressed_srgb_alpha_s3tc_dxt5},
+        {80, Format::compressed_red_rgtc1},
+        {81, Format::compressed_signed_red_rgtc1},
+        {83, Format::compressed_rg_rgtc2},
+        {84, Format::compressed_signed_rg_rgtc2},
+        {87, Format::rgba8, DataFormat::bgra, DataType::ubyte},
+        {91, Format::srgb8_alpha8, DataFormat::bgra, DataType::ubyte},
+        {95, Format::compressed_rgb_bptc_unsigned_float},
+        {96, Format::compressed_rgb_bptc_signed_float},
+        {98, Format::compressed_rgba_bptc_unorm},
+        {99, Format::compressed_srgb_alpha_bptc_unorm},
+};
+
+constexpr auto fourCC(const char (&code)[5]) -> std::uint32_t
+{
+    return std::uint32_t(std::uint8_t(code[0])) | std::uint32_t(std::uint8_t(code[1])) << 8
+           | std::uint32_t(std::uint8_t(code[2])) << 16 | std::uint32_t(std::uint8_t(code[3])) << 24;
+}
+
+// FourCC codes of DDS files without a DX10 header
+constexpr FormatInfo four_cc_formats[] = {
+        {fourCC("DXT1"), Format::compressed_rgba_s3tc_dxt1},
+        {fourCC("DXT3"), Format::compressed_rgba_s3tc_dxt3},
+        {fourCC("DXT5"), Format::compressed_rgba_s3tc_dxt5},
+        {fourCC("ATI1"), Format::compressed_red_rgtc1},
+        {fourCC("BC4U"), Format::compressed_red_rgtc1},
+        {fourCC("BC4S"), Format::compressed_signed_red_rgtc1},
+        {fourCC("ATI2"), Format::compressed_rg_rgtc2},
+        {fourCC("BC5U"), Format::compressed_rg_rgtc2},
+        {fourCC("BC5S"), Format::compressed_signed_rg_rgtc2},
+};
+
+template<std::size_t N>
+auto findFormat(const FormatInfo (&formats)[N], std::uint32_t code, const char *container) -> const FormatInfo &
+{
+    const auto format = std::find_if(std::begin(formats), std::end(formats),
+                                     [code](const FormatInfo &info) { return info.code == code; });
+    if (format == std::end(formats))
+        throw Error(std::string("unsupported ") + container + " format " + std::to_string(code));
+    return *format;
+}
+
+auto read32(const unsigned char *data, std::size_t offset) -> std::uint32_t
+{
+    std::uint32_t value;
+    std::memcpy(&value, data + offset, sizeof(value));
+    return value;
+}
+
+auto read64(const unsigned char *data, std::size_t offset) -> std::uint64_t
+{
+    std::uint64_t value;
+    std::memcpy(&value, data + offset, sizeof(value));
+    return value;
+}
+
+constexpr unsigned char ktx2_identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+constexpr std::size_t ktx2_level_index_offset = 80;
+
+constexpr std::uint32_t dds_magic = fourCC("DDS ");
+constexpr std::size_t dds_header_size = 4 + 124;
+constexpr std::size_t dds_dx10_header_size = 20;
+constexpr std::uint32_t ddpf_fourcc = 0x4;
+constexpr std::uint32_t ddpf_rgb = 0x40;
+constexpr std::uint32_t ddscaps2_cubemap = 0x200;
+constexpr std::uint32_t ddscaps2_volume = 0x200000;
+constexpr std::uint32_t dx10_resource_texture3d = 4;
+constexpr std::uint32_t dx10_misc_texturecube = 0x4;
+
+// larger than any GL_MAX_TEXTURE_SIZE, and small enough that image sizes can't overflow
+constexpr std::uint32_t max_dimension = 1 << 16;
+
+void checkSize(std::uint32_t width, std::uint32_t height, std::uint32_t depth, std::uint32_t layers)
+{
+    if (width == 0 || height == 0)
+        throw Error("textures without pixels aren't supported");
+    if (width > max_dimension || height > max_dimension || depth > max_dimension || layers > max_dimension)
+        throw Error("texture of " + std::to_string(width) + "x" + std::to_string(height) + "x"
+                    + std::to_string(std::max(depth, layers)) + " is too large");
+}
+
+// levels beyond the one of size 1x1x1 don't exist
+void checkLevels(std::uint32_t levels, std::uint32_t width, std::uint32_t height, std::uint32_t depth)
+{
+    std::uint32_t max_levels = 1;
+    for (auto size = std::max({width, height, depth}); size > 1; size >>= 1)
+        max_levels++;
+
+    if (levels > max_levels)
+        throw Error(std::to_string(levels) + " levels exceed the " + std::to_string(max_levels) + " of a "
+                    + std::to_string(width) + "x" + std::to_string(height) + " texture");
+}
+
+} // namespace
+
+TextureContainer::TextureContainer(const unsigned char *data, std::size_t size)
+{
+    if (size >= sizeof(ktx2_identifier) && std::memcmp(data, ktx2_identifier, sizeof(ktx2_identifier)) == 0)
+        parseKTX2(data, size);
+    else if (size >= 4 && read32(data, 0) == dds_magic)
+        parseDDS(data, size);
+    else
+        throw Error("not a KTX2 or DDS file");
+
+    std::stable_sort(m_images.begin(), m_images.end(),
+                     [](const Image &left, const Image &right) { return left.level > right.level; });
+}
+
+auto TextureContainer::getRowSize(GLsizei width) const -> std::size_t
+{
+    const auto block_size = TextureHandle::getBlockSize(m_format);
+    if (block_size != 0)
+        return std::size_t((width + 3) / 4) * block_size;
+    return std::size_t(width) * m_pixel_size;
+}
+
+void TextureContainer::parseKTX2(const unsigned char *data, std::size_t size)
+{
+    if (size < ktx2_level_index_offset)
+        throw Error("truncated KTX2 header");
+
+    const auto vk_format = read32(data, 12);
+    const auto width = read32(data, 20);
+    const auto height = read32(data, 24);
+    const auto depth = read32(data, 28);
+    const auto layers = read32(data, 32);
+    const auto faces = read32(data, 36);
+    const auto levels = std::max(read32(data, 40), 1u);
+    const auto supercompression = read32(data, 44);
+
+    if (supercompression != 0)
+        throw Error("supercompressed KTX2 files aren't supported");
+    if (width != 0 && height == 0)
+        throw Error("1D textures aren't supported");
+    if (vk_format == 0)
+        throw Error("KTX2 files without a VkFormat aren't supported");
+    if (faces != 0 && faces != 1 && faces != 6)
+        throw Error("KTX2 file with " + std::to_string(faces) + " faces");
+
+    checkSize(width, height, depth, layers);
+    checkLevels(levels, width, height, depth);
+
+    const auto &format = findFormat(vk_formats, vk_format, "KTX2");
+    m_format = format.format;
+    m_data_format = format.data_format;
+    m_data_type = format.data_type;
+    m_pixel_size = isCompressed() ? 0 : TextureHandle::getPixelSize(m_data_format, m_data_type);
+
+    m_width = static_cast<GLsizei>(width);
+    m_height = static_cast<GLsizei>(height);
+    m_levels = static_cast<GLsizei>(levels);
+    setType(static_cast<GLsizei>(layers), layers > 0, static_cast<GLsizei>(faces), depth > 0);
+    if (depth > 0)
+        m_depth = static_cast<GLsizei>(depth);
+
+    if (size < ktx2_level_index_offset + std::size_t(levels) * 24)
+        throw Error("truncated KTX2 level index");
+
+    // each level holds its layers, each layer its faces, each face its slices
+    for (GLint level = 0; level < m_levels; level++)
+    {
+        const auto entry = ktx2_level_index_offset + std::size_t(level) * 24;
+        const auto offset = read64(data, entry);
+        const auto length = read64(data, entry + 8);
+        if (offset > size || length > size - offset)
+            throw Error("truncated KTX2 level " + std::to_string(level));
+
+        const auto image_size = getImageSize(level);
+        const GLsizei slices = m_type == TextureHandle::Type::_3d ? std::max(m_depth >> level, 1) : m_depth;
+        if (length < image_size * slices)
+            throw Error("KTX2 level " + std::to_string(level) + " is too small");
+
+        for (GLint z = 0; z < slices; z++)
+        {
+            m_images.push_back({level, z, std::max(m_width >> level, 1), std::max(m_height >> level, 1),
+                                data + offset + image_size * z, image_size});
+        }
+    }
+}
+
+void TextureContainer::parseDDS(const unsigned char *data, std::size_t size)
+{
+    if (size < dds_header_size)
+        throw Error("truncated DDS header");
+
+    const auto height = read32(data, 12);
+    const auto width = read32(data, 16);
+    const auto depth = read32(data, 24);
+    const auto levels = std::max(read32(data, 28), 1u);
+    const auto pixel_format_flags = read32(data, 80);
+    const auto four_cc = read32(data, 84);
+    const auto caps2 = read32(data, 112);
+
+    checkSize(width, height, depth, 0);
+    checkLevels(levels, width, height, (caps2 & ddscaps2_volume) != 0 ? depth : 1);
+
+    m_width = static_cast<GLsizei>(width);
+    m_height = static_cast<GLsizei>(height);
+    m_levels = static_cast<GLsizei>(levels);
+
+    std::size_t offset = dds_header_size;
+    GLsizei layers = 1;
+    bool array = false;
+    bool cube = (caps2 & ddscaps2_cubemap) != 0;
+    bool volume = (caps2 & ddscaps2_volume) != 0;
+
+    if ((pixel_format_flags & ddpf_fourcc) && four_cc == fourCC("DX10"))
+    {
+        if (size < dds_header_size + dds_dx10_header_size)
+            throw Error("truncated DDS DX10 header");
+
+        const auto &format = findFormat(dxgi_formats, read32(data, offset), "DXGI");
+        m_format = format.format;
+        m_data_format = format.data_format;
+        m_data_type = format.data_type;
+
+        const auto array_size = read32(data, offset + 12);
+        checkSize(width, height, depth, array_size);
+
+        volume = read32(data, offset + 4) == dx10_resource_texture3d;
+        cube = (read32(data, offset + 8) & dx10_misc_texturecube) != 0;
+        layers = static_cast<GLsizei>(std::max(array_size, 1u));
+        array = layers > 1;
+        offset += dds_dx10_header_size;
+    }
+    else if (pixel_format_flags & ddpf_fourcc)
+    {
+        m_format = findFormat(four_cc_formats, four_cc, "DDS FourCC").format;
+    }
+    else if ((pixel_format_flags & ddpf_rgb) && read32(data, 88) == 32)
+    {
+        // only 8-bit RGBA and BGRA are supported without a DX10 header
+        const auto red_mask = read32(data, 92);
+        if (red_mask != 0x000000FF && red_mask != 0x00FF0000)
+            throw Error("unsupported DDS pixel format");
+
+        m_format = Format::rgba8;
+        m_data_format = red_mask == 0x000000FF ? DataFormat::rgba : DataFormat::bgra;
+        m_data_type = DataType::ubyte;
+    }
+    else
+    {
+        throw Error("unsupported DDS pixel format");
+    }
+
+    m_pixel_size = isCompressed() ? 0 : TextureHandle::getPixelSize(m_data_format, m_data_type);
+    setType(layers, array, cube ? 6 : 1, volume);
+    if (volume)
+        m_depth = static_cast<GLsizei>(std::max(depth, 1u));
+
+    // each layer or face holds its levels, each level its slices
+    const auto surfaces = m_type == TextureHandle::Type::_3d ? 1 : m_depth;
+    for (GLint surface = 0; surface < surfaces; surface++)
+    {
+        for (GLint level = 0; level < m_levels; level++)
+        {
+            const auto image_size = getImageSize(level);
+            const GLsizei slices = m_type == TextureHandle::Type::_3d ? std::max(m_depth >> level, 1) : 1;
+
+            for (GLint slice = 0; slice < slices; slice++)
+            {
+                if (image_size > size - offset)
+                    throw Error("truncated DDS level " + std::to_string(level));
+
+                m_images.push_back({level, m_type == TextureHandle::Type::_3d ? slice : surface,
+                                    std::max(m_width >> level, 1), std::max(m_height >> level, 1), data + offset,
+                                    image_size});
+                offset += image_size;
+            }
+        }
+    }
+}
+
+void TextureContainer::setType(GLsizei layers, bool array, GLsizei faces, bool volume)
+{
+    if (volume)
+    {
+        if (array || faces == 6)
+            throw Error("3D array and cube map textures aren't supported");
+
+        // glCompressedTextureSubImage3D accepts 3D textures only in the BPTC formats
+        const bool bptc = m_format == Format::compressed_rgba_bptc_unorm
+                          || m_format == Format::compressed_srgb_alpha_bptc_unorm
+                          || m_format == Format::compressed_rgb_bptc_signed_float
+                          || m_format == Format::compressed_rgb_bptc_unsigned_float;
+        if (isCompressed() && !bptc)
+            throw Error("3D textures can't have a BC1-5, ETC2 or EAC format");
+
+        m_type = TextureHandle::Type::_3d;
+    }
+    else if (faces == 6)
+    {
+        if (array)
+            throw Error("cube map arrays aren't supported");
+        m_type = TextureHandle::Type::cube_map;
+        m_depth = 6;
+    }
+    else if (array)
+    {
+        m_type = TextureHandle::Type::_2d_array;
+        m_depth = layers;
+    }
+    else
+    {
+        m_type = TextureHandle::Type::_2d;
+    }
+}
+
+auto TextureContainer::getImageSize(GLint level) const -> std::size_t
+{
+    const auto width = std::max(m_width >> level, 1);
+    const auto height = std::max(m_height >> level, 1);
+    const auto rows = isCompressed() ? (height + 3) / 4 : height;
+    return getRowSize(width) * rows;
+}
+
+} // GL
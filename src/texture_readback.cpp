@@ -0,0 +1,165 @@
+#include "glutils/texture_readback.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace GL {
+
+namespace {
+
+// keeps readbacks cache line and SIMD aligned, for encoders reading them in place
+constexpr GLsizeiptr readback_alignment = 64;
+
+} // namespace
+
+TextureReadback::TextureReadback(GLsizeiptr capacity)
+        : m_capacity(capacity)
+{
+    using StorageFlags = BufferHandle::StorageFlags;
+    using AccessFlags = BufferHandle::AccessFlags;
+
+    m_buffer.allocateImmutable(capacity, StorageFlags::map_read | StorageFlags::map_persistent
+                                         | StorageFlags::map_coherent | StorageFlags::client_storage);
+    m_data = static_cast<const std::byte *>(m_buffer.mapRange(0, capacity, AccessFlags::read | AccessFlags::persistent
+                                                                            | AccessFlags::coherent));
+    if (!m_data)
+        throw Error("failed to map texture readback buffer");
+}
+
+auto TextureReadback::request(TextureHandle texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                              GLsizei width, GLsizei height, GLsizei depth, TextureHandle::DataFormat format,
+                              TextureHandle::DataType type) -> std::optional<ReadbackId>
+{
+    if (width <= 0 || height <= 0 || depth <= 0)
+        throw Error("texture readback of an empty region");
+
+    GLint alignment;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+
+    const GLsizeiptr row_size = GLsizeiptr(width) * TextureHandle::getPixelSize(format, type);
+    const GLsizeiptr row_stride = (row_size + alignment - 1) / alignment * alignment;
+    // the last row isn't padded
+    const GLsizeiptr size = (GLsizeiptr(height) * depth - 1) * row_stride + row_size;
+
+    if (size > m_capacity)
+        throw Error("texture readback of " + std::to_string(size) + " bytes exceeds the buffer capacity");
+
+    std::lock_guard lock(m_mutex);
+
+    const auto offset = allocate(size);
+    if (!offset)
+        return std::nullopt;
+
+    auto &request = m_requests.back();
+    request.readback = {m_next_id++, m_data + *offset, size, row_stride, width, height, depth};
+
+    // with a pixel pack buffer bound, the pixel pointer is an offset into the buffer
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer.getName());
+    texture.getSubImage(level, xoffset, yoffset, zoffset, width, height, depth, format, type, GLsizei(size),
+                        reinterpret_cast<void *>(*offset));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    request.fence.emplace(createFenceSync());
+
+    return request.readback.id;
+}
+
+auto TextureReadback::poll(bool wait) -> std::vector<Readback>
+{
+    std::vector<Readback> completed;
+
+    std::lock_guard lock(m_mutex);
+
+    for (auto &request: m_requests)
+    {
+        if (request.state != State::issued)
+            continue;
+
+        // flush, so the fence is submitted and signals without further commands
+        auto status = request.fence->clientWait(true);
+        while (wait && status == Sync::Status::timeout_expired)
+            status = request.fence->clientWait(true, std::chrono::milliseconds(1));
+
+        if (status != Sync::Status::already_signaled && status != Sync::Status::condition_satisfied)
+        {
+            if (status == Sync::Status::wait_failed)
+                throw Error("waiting for a texture readback failed");
+            break;
+        }
+
+        request.fence.reset();
+        request.state = State::ready;
+        completed.push_back(request.readback);
+    }
+
+    return completed;
+}
+
+void TextureReadback::release(ReadbackId id)
+{
+    std::lock_guard lock(m_mutex);
+
+    const auto iter = std::find_if(m_requests.begin(), m_requests.end(),
+                                   [id](const Request &request) { return request.readback.id == id; });
+    if (iter == m_requests.end() || iter->state != State::ready)
+        throw Error("unknown texture readback");
+
+    iter->state = State::released;
+
+    while (!m_requests.empty() && m_requests.front().state == State::released)
+        m_requests.pop_front();
+}
+
+auto TextureReadback::getPendingCount() const -> std::size_t
+{
+    std::lock_guard lock(m_mutex);
+    return m_requests.size();
+}
+
+auto TextureReadback::allocate(GLsizeiptr size) -> std::optional<GLintptr>
+{
+    const auto aligned_size = std::min((size + readback_alignment - 1) / readback_alignment * readback_alignment,
+                                       m_capacity);
+
+    GLintptr offset;
+    if (m_requests.empty())
+    {
+        offset = 0;
+    }
+    else
+    {
+        const auto tail = m_requests.front().offset;
+
+        if (m_head > tail)
+        {
+            // free memory is [head, capacity) and [0, tail)
+            if (m_capacity - m_head >= aligned_size)
+                offset = m_head;
+            else if (tail >= aligned_size)
+                offset = 0;
+            else
+                return std::nullopt;
+        }
+        else
+        {
+            // wrapped around: free memory is [head, tail)
+            if (tail - m_head >= aligned_size)
+                offset = m_head;
+            else
+                return std::nullopt;
+        }
+    }
+
+    m_head = offset + aligned_size;
+
+    auto &request = m_requests.emplace_back();
+    request.offset = offset;
+    request.size = aligned_size;
+
+    return offset;
+}
+
+} // GL
@@ -0,0 +1,252 @@
+#include "glutils/texture_streamer.hpp"
+#include "glutils/error.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace GL {
+
+namespace {
+
+// keeps reservations on separate cache lines, so threads filling neighbouring ones don't contend
+constexpr GLsizeiptr staging_alignment = 64;
+
+} // namespace
+
+TextureStreamer::TextureStreamer(GLsizeiptr capacity)
+        : m_capacity(capacity)
+{
+    using StorageFlags = BufferHandle::StorageFlags;
+    using AccessFlags = BufferHandle::AccessFlags;
+
+    m_buffer.allocateImmutable(capacity, StorageFlags::map_write | StorageFlags::map_persistent
+                                         | StorageFlags::map_coherent);
+    m_data = static_cast<std::byte *>(m_buffer.mapRange(0, capacity, AccessFlags::write | AccessFlags::persistent
+                                                                      | AccessFlags::coherent));
+    if (!m_data)
+        throw Error("failed to map texture staging buffer");
+}
+
+auto TextureStreamer::tryReserve(GLsizeiptr size) -> std::optional<Staging>
+{
+    std::lock_guard lock(m_mutex);
+    return allocate(size);
+}
+
+auto TextureStreamer::reserve(GLsizeiptr size) -> Staging
+{
+    std::unique_lock lock(m_mutex);
+
+    while (true)
+    {
+        if (auto staging = allocate(size))
+            return *staging;
+
+        m_released.wait(lock);
+    }
+}
+
+void TextureStreamer::submit(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset,
+                             GLint yoffset, GLsizei width, GLsizei height, TextureHandle::DataFormat format,
+                             TextureHandle::DataType type)
+{
+    Upload region;
+    region.texture = texture;
+    region.dimensions = 2;
+    region.level = level;
+    region.xoffset = xoffset;
+    region.yoffset = yoffset;
+    region.width = width;
+    region.height = height;
+    region.format = format;
+    region.type = type;
+    submit(staging, region);
+}
+
+void TextureStreamer::submit1D(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset,
+                               GLsizei width, TextureHandle::DataFormat format, TextureHandle::DataType type)
+{
+    Upload region;
+    region.texture = texture;
+    region.dimensions = 1;
+    region.level = level;
+    region.xoffset = xoffset;
+    region.width = width;
+    region.format = format;
+    region.type = type;
+    submit(staging, region);
+}
+
+void TextureStreamer::submit3D(const Staging &staging, TextureHandle texture, GLint level, GLint xoffset,
+                               GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                               TextureHandle::DataFormat format, TextureHandle::DataType type)
+{
+    Upload region;
+    region.texture = texture;
+    region.dimensions = 3;
+    region.level = level;
+    region.xoffset = xoffset;
+    region.yoffset = yoffset;
+    region.zoffset = zoffset;
+    region.width = width;
+    region.height = height;
+    region.depth = depth;
+    region.format = format;
+    region.type = type;
+    submit(staging, region);
+}
+
+void TextureStreamer::submit(const Staging &staging, const Upload &region)
+{
+    std::lock_guard lock(m_mutex);
+
+    for (auto &upload: m_uploads)
+    {
+        if (upload.id != staging.id)
+            continue;
+
+        upload.texture = region.texture;
+        upload.dimensions = region.dimensions;
+        upload.level = region.level;
+        upload.xoffset = region.xoffset;
+        upload.yoffset = region.yoffset;
+        upload.zoffset = region.zoffset;
+        upload.width = region.width;
+        upload.height = region.height;
+        upload.depth = region.depth;
+        upload.format = region.format;
+        upload.type = region.type;
+        upload.state = State::submitted;
+        return;
+    }
+
+    throw Error("unknown texture upload");
+}
+
+void TextureStreamer::issue()
+{
+    std::lock_guard lock(m_mutex);
+
+    bool bound = false;
+
+    for (auto &upload: m_uploads)
+    {
+        if (upload.state != State::submitted)
+            continue;
+
+        if (!bound)
+        {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffer.getName());
+            bound = true;
+        }
+
+        // with a pixel unpack buffer bound, the pixel pointer is an offset into the buffer
+        const auto pixels = reinterpret_cast<const void *>(upload.offset);
+        switch (upload.dimensions)
+        {
+            case 1:
+                upload.texture.updateImage1D(upload.level, upload.xoffset, upload.width, upload.format, upload.type,
+                                             pixels);
+                break;
+            case 2:
+                upload.texture.updateImage2D(upload.level, upload.xoffset, upload.yoffset, upload.width,
+                                             upload.height, upload.format, upload.type, pixels);
+                break;
+            default:
+                upload.texture.updateImage3D(upload.level, upload.xoffset, upload.yoffset, upload.zoffset,
+                                             upload.width, upload.height, upload.depth, upload.format, upload.type,
+                                             pixels);
+                break;
+        }
+        upload.fence.emplace(createFenceSync());
+        upload.state = State::issued;
+    }
+
+    if (bound)
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+auto TextureStreamer::poll() -> std::vector<UploadId>
+{
+    std::vector<UploadId> completed;
+
+    {
+        std::lock_guard lock(m_mutex);
+
+        while (!m_uploads.empty())
+        {
+            const auto &upload = m_uploads.front();
+            if (upload.state != State::issued)
+                break;
+
+            // flush, so the fence is submitted and signals without further commands
+            const auto status = upload.fence->clientWait(true);
+            if (status != Sync::Status::already_signaled && status != Sync::Status::condition_satisfied)
+                break;
+
+            completed.push_back(upload.id);
+            m_uploads.pop_front();
+        }
+    }
+
+    if (!completed.empty())
+        m_released.notify_all();
+
+    return completed;
+}
+
+auto TextureStreamer::getPendingCount() const -> std::size_t
+{
+    std::lock_guard lock(m_mutex);
+    return m_uploads.size();
+}
+
+auto TextureStreamer::allocate(GLsizeiptr size) -> std::optional<Staging>
+{
+    if (size > m_capacity)
+        throw Error("texture upload of " + std::to_string(size) + " bytes exceeds the staging buffer capacity");
+
+    const auto aligned_size = std::min((size + staging_alignment - 1) / staging_alignment * staging_alignment,
+                                       m_capacity);
+
+    GLintptr offset;
+    if (m_uploads.empty())
+    {
+        offset = 0;
+    }
+    else
+    {
+        const auto tail = m_uploads.front().offset;
+
+        if (m_head > tail)
+        {
+            // free memory is [head, capacity) and [0, tail)
+            if (m_capacity - m_head >= aligned_size)
+                offset = m_head;
+            else if (tail >= aligned_size)
+                offset = 0;
+            else
+                return std::nullopt;
+        }
+        else
+        {
+            // wrapped around: free memory is [head, tail)
+            if (tail - m_head >= aligned_size)
+                offset = m_head;
+            else
+                return std::nullopt;
+        }
+    }
+
+    m_head = offset + aligned_size;
+
+    auto &upload = m_uploads.emplace_back();
+    upload.id = m_next_id++;
+    upload.offset = offset;
+    upload.size = aligned_size;
+
+    return Staging{upload.id, m_data + offset, size};
+}
+
+} // GL
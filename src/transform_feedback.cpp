@@ -0,0 +1,103 @@
+#include "glutils/transform_feedback.hpp"
+#include "glutils/gl.hpp"
+
+namespace GL {
+
+auto TransformFeedbackHandle::create() -> TransformFeedbackHandle
+{
+    GLuint name;
+    glCreateTransformFeedbacks(1, &name);
+    return TransformFeedbackHandle{name};
+}
+
+void TransformFeedbackHandle::destroy(TransformFeedbackHandle transform_feedback)
+{
+    glDeleteTransformFeedbacks(1, &transform_feedback.m_name);
+}
+
+auto TransformFeedbackHandle::getParameter(Parameter parameter) const -> GLint
+{
+    GLint value;
+    glGetTransformFeedbackiv(m_name, static_cast<GLenum>(parameter), &value);
+    return value;
+}
+
+void TransformFeedbackHandle::bind() const
+{
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, m_name);
+}
+
+void TransformFeedbackHandle::unbind()
+{
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, 0);
+}
+
+void TransformFeedbackHandle::bindBuffer(GLuint index, BufferHandle buffer) const
+{
+    glTransformFeedbackBufferBase(m_name, index, buffer.getName());
+}
+
+void TransformFeedbackHandle::bindBufferRange(GLuint index, BufferHandle buffer, GLintptr offset,
+                                              GLsizeiptr size) const
+{
+    glTransformFeedbackBufferRange(m_name, index, buffer.getName(), offset, size);
+}
+
+void TransformFeedbackHandle::begin(PrimitiveMode mode)
+{
+    glBeginTransformFeedback(static_cast<GLenum>(mode));
+}
+
+void TransformFeedbackHandle::end()
+{
+    glEndTransformFeedback();
+}
+
+void TransformFeedbackHandle::pause()
+{
+    glPauseTransformFeedback();
+}
+
+void TransformFeedbackHandle::resume()
+{
+    glResumeTransformFeedback();
+}
+
+void TransformFeedbackHandle::draw(PrimitiveMode mode) const
+{
+    glDrawTransformFeedback(static_cast<GLenum>(mode), m_name);
+}
+
+void TransformFeedbackHandle::drawInstanced(PrimitiveMode mode, GLsizei instance_count) const
+{
+    glDrawTransformFeedbackInstanced(static_cast<GLenum>(mode), m_name, instance_count);
+}
+
+void TransformFeedbackHandle::drawStream(PrimitiveMode mode, GLuint stream) const
+{
+    glDrawTransformFeedbackStream(static_cast<GLenum>(mode), m_name, stream);
+}
+
+void TransformFeedbackHandle::drawStreamInstanced(PrimitiveMode mode, GLuint stream, GLsizei instance_count) const
+{
+    glDrawTransformFeedbackStreamInstanced(static_cast<GLenum>(mode), m_name, stream, instance_count);
+}
+
+TransformFeedbackScope::TransformFeedbackScope(TransformFeedbackHandle transform_feedback,
+                                               TransformFeedbackHandle::PrimitiveMode mode)
+{
+    GLint previous = 0;
+    glGetIntegerv(GL_TRANSFORM_FEEDBACK_BINDING, &previous);
+    m_previous = static_cast<GLuint>(previous);
+
+    transform_feedback.bind();
+    TransformFeedbackHandle::begin(mode);
+}
+
+TransformFeedbackScope::~TransformFeedbackScope()
+{
+    TransformFeedbackHandle::end();
+    glBindTransformFeedback(GL_TRANSFORM_FEEDBACK, m_previous);
+}
+
+} // GL
@@ -0,0 +1,94 @@
+#include "glutils/uniform_block_writer.hpp"
+#include "glutils/error.hpp"
+
+#include <algorithm>
+
+namespace GL {
+
+UniformBlockWriter::UniformBlockWriter(const ProgramReflection &reflection, std::uint64_t block_key)
+{
+    const auto block = reflection.find(ProgramReflection::Interface::uniform_block, block_key);
+    if (!block)
+        throw Error("program has no active uniform block with the given name");
+
+    m_block_index = block->index;
+    m_data.resize(std::max(block->buffer_data_size, 0));
+
+    const auto [begin, end] = reflection.getResources(ProgramReflection::Interface::uniform);
+    for (auto uniform = begin; uniform != end; ++uniform)
+        if (uniform->block_index == static_cast<GLint>(m_block_index))
+            m_members.push_back({uniform->key, uniform->offset, uniform->array_stride, uniform->matrix_stride});
+
+    std::sort(m_members.begin(), m_members.end(),
+              [](const Member &l, const Member &r) { return l.key < r.key; });
+
+    markDirty();
+}
+
+auto UniformBlockWriter::getOffset(std::uint64_t key) const -> GLint
+{
+    const auto member = findMember(key);
+    return member ? member->offset : -1;
+}
+
+void UniformBlockWriter::write(GLint offset, const void *data, std::size_t size)
+{
+    if (offset < 0 || offset + size > m_data.size())
+        throw Error("uniform block write is out of bounds");
+
+    std::memcpy(m_data.data() + offset, data, size);
+
+    if (isDirty())
+    {
+        m_dirty_begin = std::min<std::size_t>(m_dirty_begin, offset);
+        m_dirty_end = std::max<std::size_t>(m_dirty_end, offset + size);
+    }
+    else
+    {
+        m_dirty_begin = offset;
+        m_dirty_end = offset + size;
+    }
+}
+
+void UniformBlockWriter::upload(BufferHandle buffer, GLintptr buffer_offset)
+{
+    if (!isDirty())
+        return;
+
+    buffer.write(buffer_offset + static_cast<GLintptr>(m_dirty_begin),
+                 static_cast<GLsizeiptr>(m_dirty_end - m_dirty_begin), m_data.data() + m_dirty_begin);
+    m_dirty_begin = m_dirty_end = 0;
+}
+
+void UniformBlockWriter::upload(void *mapped)
+{
+    if (!isDirty())
+        return;
+
+    std::memcpy(static_cast<unsigned char *>(mapped) + m_dirty_begin, m_data.data() + m_dirty_begin,
+                m_dirty_end - m_dirty_begin);
+    m_dirty_begin = m_dirty_end = 0;
+}
+
+void UniformBlockWriter::markDirty()
+{
+    m_dirty_begin = 0;
+    m_dirty_end = m_data.size();
+}
+
+void UniformBlockWriter::bind(ProgramHandle program, GLuint binding, BufferHandle buffer,
+                              GLintptr buffer_offset) const
+{
+    program.setUniformBlockBinding(m_block_index, binding);
+    buffer.bindRange(BufferHandle::IndexedTarget::uniform, binding, buffer_offset, getSize());
+}
+
+auto UniformBlockWriter::findMember(std::uint64_t key) const -> const Member *
+{
+    const auto iter = std::lower_bound(m_members.begin(), m_members.end(), key,
+                                       [](const Member &member, std::uint64_t k) { return member.key < k; });
+
+    return (iter != m_members.end() && iter->key == key) ? &*iter : nullptr;
+}
+
+} // GL
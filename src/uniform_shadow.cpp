@@ -0,0 +1,151 @@
+#include "glutils/uniform_shadow.hpp"
+#include "glutils/gl.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace GL {
+
+UniformShadow::UniformShadow(ProgramHandle program, const ProgramReflection &reflection) : m_program(program)
+{
+    const auto [begin, end] = reflection.getResources(ProgramReflection::Interface::uniform);
+
+    GLint max_location = -1;
+    for (auto uniform = begin; uniform != end; ++uniform)
+        if (uniform->location >= 0)
+            max_location = std::max(max_location, uniform->location + std::max(uniform->array_size, 1) - 1);
+
+    m_slots.resize(max_location + 1);
+
+    std::size_t offset = 0;
+    for (auto uniform = begin; uniform != end; ++uniform)
+    {
+        if (uniform->location < 0)
+            continue;
+
+        const auto size = getUniformTypeSize(uniform->type);
+        for (GLint i = 0; i < std::max(uniform->array_size, 1); i++)
+        {
+            m_slots[uniform->location + i] = Slot{offset, size, false};
+            offset += size;
+        }
+    }
+
+    m_values.resize(offset);
+}
+
+void UniformShadow::invalidate()
+{
+    for (auto &slot: m_slots)
+        slot.known = false;
+}
+
+bool UniformShadow::update(GLint location, GLsizei count, const void *data, std::size_t element_size)
+{
+    // GL silently ignores writes to location -1
+    if (location < 0 || count <= 0)
+    {
+        m_skipped_count++;
+        return false;
+    }
+
+    const auto last = static_cast<std::size_t>(location) + count - 1;
+
+    // values that don't map onto consecutive, equally sized slots can't be compared
+    if (last >= m_slots.size()
+        || m_slots[location].size != element_size
+        || m_slots[last].offset != m_slots[location].offset + (count - 1) * element_size)
+    {
+        forget(location, count);
+        m_issued_count++;
+        return true;
+    }
+
+    bool known = true;
+    for (auto i = static_cast<std::size_t>(location); i <= last; i++)
+        known = known && m_slots[i].known;
+
+    const auto size = count * element_size;
+    unsigned char *stored = m_values.data() + m_slots[location].offset;
+
+    if (known && std::memcmp(stored, data, size) == 0)
+    {
+        m_skipped_count++;
+        return false;
+    }
+
+    std::memcpy(stored, data, size);
+    for (auto i = static_cast<std::size_t>(location); i <= last; i++)
+        m_slots[i].known = true;
+
+    m_issued_count++;
+    return true;
+}
+
+void UniformShadow::forget(GLint location, GLsizei count)
+{
+    for (GLint i = std::max(location, 0); i < location + count && i < GLint(m_slots.size()); i++)
+        m_slots[i].known = false;
+}
+
+auto getUniformTypeSize(GLenum type) -> std::size_t
+{
+    switch (type)
+    {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_BOOL:
+            return 4;
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_BOOL_VEC2:
+        case GL_DOUBLE:
+            return 8;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_BOOL_VEC3:
+            return 12;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_BOOL_VEC4:
+        case GL_DOUBLE_VEC2:
+        case GL_FLOAT_MAT2:
+            return 16;
+        case GL_DOUBLE_VEC3:
+        case GL_FLOAT_MAT2x3:
+        case GL_FLOAT_MAT3x2:
+            return 24;
+        case GL_DOUBLE_VEC4:
+        case GL_FLOAT_MAT2x4:
+        case GL_FLOAT_MAT4x2:
+        case GL_DOUBLE_MAT2:
+            return 32;
+        case GL_FLOAT_MAT3:
+            return 36;
+        case GL_FLOAT_MAT3x4:
+        case GL_FLOAT_MAT4x3:
+        case GL_DOUBLE_MAT2x3:
+        case GL_DOUBLE_MAT3x2:
+            return 48;
+        case GL_FLOAT_MAT4:
+        case GL_DOUBLE_MAT2x4:
+        case GL_DOUBLE_MAT4x2:
+            return 64;
+        case GL_DOUBLE_MAT3:
+            return 72;
+        case GL_DOUBLE_MAT3x4:
+        case GL_DOUBLE_MAT4x3:
+            return 96;
+        case GL_DOUBLE_MAT4:
+            return 128;
+        default:
+            // samplers, images and atomic counters are set as a single int
+            return 4;
+    }
+}
+
+} // GL
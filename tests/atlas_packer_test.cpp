@@ -0,0 +1,110 @@
+#include "glutils/texture_atlas.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Inserts and removes random rectangles, checking after every step that placed rectangles stay inside their layer
+// and don't overlap, and that removing all of them gives back every layer whole.
+
+namespace {
+
+using Rect = GL::AtlasPacker::Rect;
+
+int g_failures = 0;
+
+void expect(bool condition, const char *what, unsigned seed, int step)
+{
+    if (condition)
+        return;
+
+    std::cerr << "seed " << seed << ", step " << step << ": " << what << "\n";
+    g_failures++;
+}
+
+// the rectangle grown by the padding on each side
+auto withPadding(const Rect &rect, GLsizei padding) -> Rect
+{
+    return {rect.layer, rect.x - padding, rect.y - padding, rect.width + 2 * padding, rect.height + 2 * padding};
+}
+
+bool overlap(const Rect &a, const Rect &b)
+{
+    return a.layer == b.layer && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height
+           && b.y < a.y + a.height;
+}
+
+void run(unsigned seed, GLsizei size, GLsizei layers, GLsizei padding, GLsizei alignment)
+{
+    GL::AtlasPacker packer(size, size, layers, padding, alignment);
+    const auto total_area = std::int64_t(size) * size * layers;
+
+    std::mt19937 random(seed);
+    std::vector<Rect> placed;
+
+    for (int step = 0; step < 200; step++)
+    {
+        if (placed.empty() || random() % 3 != 0)
+        {
+            const auto width = GLsizei(1 + random() % (size / 4));
+            const auto height = GLsizei(1 + random() % (size / 4));
+            const auto rect = packer.insert(width, height);
+            if (!rect)
+                continue;
+
+            const auto cell = withPadding(*rect, padding);
+            expect(rect->width == width && rect->height == height, "inserted rectangle has the wrong size", seed, step);
+            expect(cell.layer >= 0 && cell.layer < layers && cell.x >= 0 && cell.y >= 0 && cell.x + cell.width <= size
+                   && cell.y + cell.height <= size, "inserted rectangle is out of bounds", seed, step);
+            expect(cell.x % alignment == 0 && cell.y % alignment == 0, "inserted rectangle is not aligned", seed,
+                   step);
+
+            for (const auto &other: placed)
+                expect(!overlap(cell, withPadding(other, padding)), "inserted rectangle overlaps another", seed, step);
+
+            placed.push_back(*rect);
+        }
+        else
+        {
+            const auto index = random() % placed.size();
+            packer.remove(placed[index]);
+            placed.erase(placed.begin() + std::ptrdiff_t(index));
+        }
+
+        expect(packer.getFreeArea() <= total_area, "free area exceeds the atlas", seed, step);
+    }
+
+    while (!placed.empty())
+    {
+        packer.remove(placed.back());
+        placed.pop_back();
+    }
+
+    expect(packer.getFreeArea() == total_area, "free area not recovered after removing everything", seed, -1);
+    expect(packer.getFreeRectCount() == std::size_t(layers), "free space of an empty layer is fragmented", seed, -1);
+
+    const auto full = size - 2 * padding;
+    for (GLsizei layer = 0; layer < layers; layer++)
+        expect(packer.insert(full, full).has_value(), "full-size insertion into an emptied layer failed", seed, -1);
+}
+
+} // namespace
+
+int main()
+{
+    for (unsigned seed = 1; seed <= 50; seed++)
+    {
+        run(seed, 256, 2, 0, 1);
+        run(seed, 256, 3, 2, 4);
+    }
+
+    if (g_failures > 0)
+    {
+        std::cerr << g_failures << " failures\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+#include "glutils/block_compression.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Decodes hand-assembled BC1 and BC4 blocks against the palettes the specifications give, then compresses noisy
+// images of every format and size class, checking the quality of the round trip and that splitting the rows between
+// threads doesn't change the output.
+
+namespace {
+
+using GL::BlockFormat;
+
+int g_failures = 0;
+
+void expect(bool condition, const std::string &what)
+{
+    if (condition)
+        return;
+
+    std::cerr << what << "\n";
+    g_failures++;
+}
+
+auto decodeBlock(BlockFormat format, const std::uint8_t *block) -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> pixels(16 * 4);
+    GL::decompressBlocks(format, block, 4, 4, pixels.data());
+    return pixels;
+}
+
+// 2-bit or 3-bit indices of the 16 pixels, least significant first
+auto packIndices(const int (&indices)[16], int bits) -> std::uint64_t
+{
+    std::uint64_t packed = 0;
+    for (int i = 0; i < 16; i++)
+        packed |= std::uint64_t(indices[i]) << (bits * i);
+    return packed;
+}
+
+void testBC1KnownAnswers()
+{
+    constexpr int indices[16] = {0, 1, 2, 3, 3, 2, 1, 0, 0, 0, 1, 1, 2, 2, 3, 3};
+    const auto bits = packIndices(indices, 2);
+
+    // four color mode, color0 > color1: pure red and pure blue, with the thirds in between
+    {
+        const std::uint8_t block[8] = {0x00, 0xF8, 0x1F, 0x00, std::uint8_t(bits), std::uint8_t(bits >> 8),
+                                       std::uint8_t(bits >> 16), std::uint8_t(bits >> 24)};
+        constexpr std::uint8_t palette[4][3] = {{255, 0, 0}, {0, 0, 255}, {170, 0, 85}, {85, 0, 170}};
+
+        const auto pixels = decodeBlock(BlockFormat::bc1, block);
+        for (int i = 0; i < 16; i++)
+        {
+            expect(std::memcmp(&pixels[i * 4], palette[indices[i]], 3) == 0 && pixels[i * 4 + 3] == 255,
+                   "bc1 four color block decoded wrong at pixel " + std::to_string(i));
+        }
+    }
+
+    // three color mode, color0 <= color1: white is 0xFFFF, index 2 is the average and index 3 is black
+    {
+        const std::uint8_t block[8] = {0x00, 0x00, 0xFF, 0xFF, std::uint8_t(bits), std::uint8_t(bits >> 8),
+                                       std::uint8_t(bits >> 16), std::uint8_t(bits >> 24)};
+        constexpr std::uint8_t palette[4][3] = {{0, 0, 0}, {255, 255, 255}, {127, 127, 127}, {0, 0, 0}};
+
+        const auto pixels = decodeBlock(BlockFormat::bc1, block);
+        for (int i = 0; i < 16; i++)
+        {
+            expect(std::memcmp(&pixels[i * 4], palette[indices[i]], 3) == 0,
+                   "bc1 three color block decoded wrong at pixel " + std::to_string(i));
+        }
+    }
+
+    // a solid color representable in 5:6:5 is encoded exactly
+    {
+        std::vector<std::uint8_t> pixels(16 * 4);
+        for (int i = 0; i < 16; i++)
+        {
+            pixels[i * 4] = 255;
+            pixels[i * 4 + 1] = 0;
+            pixels[i * 4 + 2] = 0;
+            pixels[i * 4 + 3] = 255;
+        }
+
+        const auto block = GL::compressBlocks(BlockFormat::bc1, pixels.data(), 4, 4, 1);
+        expect(block[0] == 0x00 && block[1] == 0xF8, "solid red bc1 block has the wrong endpoint");
+        expect(decodeBlock(BlockFormat::bc1, block.data()) == pixels, "solid red bc1 block doesn't round trip");
+    }
+}
+
+void testBC4KnownAnswers()
+{
+    constexpr int indices[16] = {0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0};
+    const auto bits = packIndices(indices, 3);
+
+    std::uint8_t block[8] = {0, 0};
+    for (int i = 0; i < 6; i++)
+        block[2 + i] = std::uint8_t(bits >> (8 * i));
+
+    // eight value mode, red0 > red1: six interpolated values, here in exact steps of 10
+    {
+        block[0] = 210;
+        block[1] = 140;
+        constexpr std::uint8_t palette[8] = {210, 140, 200, 190, 180, 170, 160, 150};
+
+        const auto pixels = decodeBlock(BlockFormat::bc4, block);
+        for (int i = 0; i < 16; i++)
+        {
+            expect(pixels[i * 4] == palette[indices[i]] && pixels[i * 4 + 1] == 0 && pixels[i * 4 + 3] == 255,
+                   "bc4 eight value block decoded wrong at pixel " + std::to_string(i));
+        }
+    }
+
+    // six value mode, red0 <= red1: four interpolated values, then 0 and 255
+    {
+        block[0] = 100;
+        block[1] = 200;
+        constexpr std::uint8_t palette[8] = {100, 200, 120, 140, 160, 180, 0, 255};
+
+        const auto pixels = decodeBlock(BlockFormat::bc4, block);
+        for (int i = 0; i < 16; i++)
+        {
+            expect(pixels[i * 4] == palette[indices[i]],
+                   "bc4 six value block decoded wrong at pixel " + std::to_string(i));
+        }
+    }
+}
+
+// a smooth gradient per channel, plus noise of up to +-noise
+auto makeImage(GLsizei width, GLsizei height, int noise, unsigned seed) -> std::vector<std::uint8_t>
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> offset(-noise, noise);
+
+    std::vector<std::uint8_t> pixels(std::size_t(width) * height * 4);
+    for (GLsizei y = 0; y < height; y++)
+    {
+        for (GLsizei x = 0; x < width; x++)
+        {
+            const int base[4] = {x * 3, y * 3, (x + y) * 2, int(128.0 + 100.0 * std::sin(x * 0.15 + y * 0.1))};
+            for (int channel = 0; channel < 4; channel++)
+            {
+                pixels[(std::size_t(y) * width + x) * 4 + channel] = std::uint8_t(
+                        std::clamp(base[channel] + offset(random), 0, 255));
+            }
+        }
+    }
+    return pixels;
+}
+
+auto psnr(const std::vector<std::uint8_t> &a, const std::vector<std::uint8_t> &b, int channels) -> double
+{
+    double squared_error = 0.0;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < a.size(); i++)
+    {
+        if (int(i % 4) >= channels)
+            continue;
+        squared_error += std::pow(double(a[i]) - double(b[i]), 2.0);
+        count++;
+    }
+
+    if (squared_error == 0.0)
+        return INFINITY;
+    return 10.0 * std::log10(255.0 * 255.0 * double(count) / squared_error);
+}
+
+void testRoundTrip(const char *name, BlockFormat format, int channels, double min_psnr)
+{
+    constexpr GLsizei sizes[][2] = {{64, 64}, {1, 1}, {3, 5}, {13, 7}, {33, 62}};
+
+    for (const auto &[width, height]: sizes)
+    {
+        for (unsigned seed = 1; seed <= 4; seed++)
+        {
+            const auto pixels = makeImage(width, height, 12, seed);
+            const auto where = std::string(name) + " " + std::to_string(width) + "x" + std::to_string(height)
+                               + ", seed " + std::to_string(seed);
+
+            const auto blocks = GL::compressBlocks(format, pixels.data(), width, height, 1);
+            expect(blocks.size() == GL::getCompressedSize(format, width, height), where + ": wrong compressed size");
+
+            // rows are split between threads, so more threads than rows and uneven shares must give the same blocks
+            for (unsigned threads: {2u, 3u, 7u, 64u})
+            {
+                expect(GL::compressBlocks(format, pixels.data(), width, height, threads) == blocks,
+                       where + ": output differs with " + std::to_string(threads) + " threads");
+            }
+
+            std::vector<std::uint8_t> decoded(pixels.size());
+            GL::decompressBlocks(format, blocks.data(), width, height, decoded.data());
+
+            const auto quality = psnr(pixels, decoded, channels);
+            expect(quality >= min_psnr, where + ": PSNR " + std::to_string(quality) + " dB is below "
+                                        + std::to_string(min_psnr) + " dB");
+
+            // channels the format doesn't store decode to 0, and alpha to 255
+            bool defaults = true;
+            for (std::size_t i = 0; i < decoded.size(); i++)
+            {
+                const int channel = int(i % 4);
+                if (channel >= channels)
+                    defaults &= decoded[i] == (channel == 3 ? 255 : 0);
+            }
+            expect(defaults, where + ": channels missing from the format don't have their default value");
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+#if defined(GLUTILS_TEST_REQUIRE_AVX2)
+    // the exit code ctest reports as skipped
+    if (!__builtin_cpu_supports("avx2"))
+        return 77;
+#endif
+
+    testBC1KnownAnswers();
+    testBC4KnownAnswers();
+
+    testRoundTrip("bc1", BlockFormat::bc1, 3, 30.0);
+    testRoundTrip("bc4", BlockFormat::bc4, 1, 40.0);
+    testRoundTrip("bc5", BlockFormat::bc5, 2, 40.0);
+    testRoundTrip("bc7", BlockFormat::bc7, 4, 30.0);
+
+    if (g_failures > 0)
+    {
+        std::cerr << g_failures << " failures\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
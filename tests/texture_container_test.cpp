@@ -0,0 +1,450 @@
+#include "glutils/error.hpp"
+#include "glutils/texture_container.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Parses KTX2 and DDS files assembled in memory: valid ones of every supported type, then truncated and malformed
+// ones, which must be rejected with GL::Error rather than read out of bounds.
+
+namespace {
+
+using Type = GL::TextureHandle::Type;
+using Format = GL::TextureHandle::SizedInternalFormat;
+using File = std::vector<unsigned char>;
+
+int g_failures = 0;
+
+void expect(bool condition, const std::string &what)
+{
+    if (condition)
+        return;
+
+    std::cerr << what << "\n";
+    g_failures++;
+}
+
+void write32(File &file, std::size_t offset, std::uint32_t value)
+{
+    if (file.size() < offset + 4)
+        file.resize(offset + 4);
+    std::memcpy(file.data() + offset, &value, 4);
+}
+
+void write64(File &file, std::size_t offset, std::uint64_t value)
+{
+    if (file.size() < offset + 8)
+        file.resize(offset + 8);
+    std::memcpy(file.data() + offset, &value, 8);
+}
+
+struct Description
+{
+    std::uint32_t format{37}; // VK_FORMAT_R8G8B8A8_UNORM, or a DXGI format or FourCC for DDS
+    std::uint32_t width{16};
+    std::uint32_t height{8};
+    std::uint32_t depth{0};
+    std::uint32_t layers{0};
+    std::uint32_t faces{1};
+    std::uint32_t levels{1};
+    // bytes per pixel, or per 4x4 block if compressed
+    std::size_t texel_size{4};
+    bool compressed{false};
+};
+
+auto getImageSize(const Description &description, std::uint32_t level) -> std::size_t
+{
+    auto width = std::max(description.width >> level, 1u);
+    auto height = std::max(description.height >> level, 1u);
+    if (description.compressed)
+    {
+        width = (width + 3) / 4;
+        height = (height + 3) / 4;
+    }
+    return width * height * description.texel_size;
+}
+
+auto makeKTX2(const Description &description) -> File
+{
+    File file = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+    write32(file, 12, description.format);
+    write32(file, 16, description.compressed ? 1 : std::uint32_t(description.texel_size));
+    write32(file, 20, description.width);
+    write32(file, 24, description.height);
+    write32(file, 28, description.depth);
+    write32(file, 32, description.layers);
+    write32(file, 36, description.faces);
+    write32(file, 40, description.levels);
+    write32(file, 44, 0);
+
+    const auto levels = std::max(description.levels, 1u);
+    file.resize(80 + levels * 24);
+
+    // levels are stored smallest first, each filled with its index
+    for (auto level = levels; level-- > 0;)
+    {
+        const auto slices = description.depth > 0 ? std::max(description.depth >> level, 1u) : 1u;
+        const auto length = getImageSize(description, level) * slices * std::max(description.layers, 1u)
+                            * description.faces;
+        write64(file, 80 + level * 24, file.size());
+        write64(file, 80 + level * 24 + 8, length);
+        write64(file, 80 + level * 24 + 16, length);
+        file.resize(file.size() + length, static_cast<unsigned char>(level));
+    }
+
+    return file;
+}
+
+constexpr std::uint32_t fourCC(const char (&code)[5])
+{
+    return std::uint32_t(std::uint8_t(code[0])) | std::uint32_t(std::uint8_t(code[1])) << 8
+           | std::uint32_t(std::uint8_t(code[2])) << 16 | std::uint32_t(std::uint8_t(code[3])) << 24;
+}
+
+// a DDS file with a DX10 header if @p dx10, else with the FourCC in format, or 32-bit RGBA if that is 0
+auto makeDDS(const Description &description, bool dx10) -> File
+{
+    File file(128, 0);
+    write32(file, 0, fourCC("DDS "));
+    write32(file, 4, 124);
+    write32(file, 12, description.height);
+    write32(file, 16, description.width);
+    write32(file, 24, description.depth);
+    write32(file, 28, description.levels);
+    write32(file, 76, 32);
+    write32(file, 112, (description.faces == 6 ? 0x200 | 0xFC00 : 0) | (description.depth > 0 ? 0x200000 : 0));
+
+    if (dx10)
+    {
+        write32(file, 80, 0x4);
+        write32(file, 84, fourCC("DX10"));
+        write32(file, 128, description.format);
+        write32(file, 132, description.depth > 0 ? 4 : 3);
+        write32(file, 136, description.faces == 6 ? 0x4 : 0);
+        write32(file, 140, std::max(description.layers, 1u));
+        write32(file, 144, 0);
+    }
+    else if (description.format != 0)
+    {
+        write32(file, 80, 0x4);
+        write32(file, 84, description.format);
+    }
+    else
+    {
+        write32(file, 80, 0x40 | 0x1);
+        write32(file, 88, 32);
+        write32(file, 92, 0x000000FF);
+        write32(file, 96, 0x0000FF00);
+        write32(file, 100, 0x00FF0000);
+        write32(file, 104, 0xFF000000);
+    }
+
+    // each layer or face holds all its levels
+    const auto levels = std::max(description.levels, 1u);
+    const auto surfaces = std::max(description.layers, 1u) * description.faces;
+    for (std::uint32_t surface = 0; surface < surfaces; surface++)
+    {
+        for (std::uint32_t level = 0; level < levels; level++)
+        {
+            const auto slices = description.depth > 0 ? std::max(description.depth >> level, 1u) : 1u;
+            file.resize(file.size() + getImageSize(description, level) * slices, static_cast<unsigned char>(level));
+        }
+    }
+
+    return file;
+}
+
+auto parse(const File &file) -> GL::TextureContainer
+{
+    return GL::TextureContainer(file.data(), file.size());
+}
+
+// images must lie in the file, and be sorted smallest level first
+void checkImages(const GL::TextureContainer &container, const File &file, const std::string &name)
+{
+    GLint previous_level = container.getLevels();
+    for (const auto &image: container.getImages())
+    {
+        expect(image.data >= file.data() && image.size <= std::size_t(file.data() + file.size() - image.data),
+               name + ": image outside of the file");
+        expect(image.level <= previous_level, name + ": images aren't sorted smallest level first");
+        previous_level = image.level;
+    }
+}
+
+void expectValid(const File &file, const std::string &name, Type type, GLsizei depth, GLsizei levels,
+                 std::size_t images, const std::function<void(const GL::TextureContainer &)> &check = {})
+{
+    try
+    {
+        const auto container = parse(file);
+        expect(container.getType() == type, name + ": wrong type");
+        expect(container.getDepth() == depth, name + ": wrong depth " + std::to_string(container.getDepth()));
+        expect(container.getLevels() == levels, name + ": wrong level count");
+        expect(container.getImages().size() == images,
+               name + ": " + std::to_string(container.getImages().size()) + " images instead of "
+               + std::to_string(images));
+        checkImages(container, file, name);
+
+        // every image of a level holds that level's index
+        for (const auto &image: container.getImages())
+        {
+            expect(image.data[0] == image.level && image.data[image.size - 1] == image.level,
+                   name + ": image of level " + std::to_string(image.level) + " points at the wrong data");
+        }
+
+        if (check)
+            check(container);
+    }
+    catch (const GL::Error &error)
+    {
+        expect(false, name + ": rejected: " + error.what());
+    }
+}
+
+void expectInvalid(const File &file, const std::string &name)
+{
+    try
+    {
+        parse(file);
+        expect(false, name + ": accepted");
+    }
+    catch (const GL::Error &)
+    {
+    }
+}
+
+void testKTX2()
+{
+    Description rgba;
+    rgba.levels = 5;
+    expectValid(makeKTX2(rgba), "KTX2 2D", Type::_2d, 1, 5, 5, [](const GL::TextureContainer &container) {
+        expect(container.getFormat() == Format::rgba8 && !container.isCompressed(), "KTX2 2D: wrong format");
+        expect(container.getImages().front().width == 1 && container.getImages().back().width == 16,
+               "KTX2 2D: wrong image sizes");
+    });
+
+    Description array = rgba;
+    array.layers = 3;
+    expectValid(makeKTX2(array), "KTX2 array", Type::_2d_array, 3, 5, 15);
+
+    Description cube = rgba;
+    cube.height = 16;
+    cube.faces = 6;
+    expectValid(makeKTX2(cube), "KTX2 cube map", Type::cube_map, 6, 5, 30);
+
+    Description volume = rgba;
+    volume.depth = 4;
+    volume.levels = 3;
+    expectValid(makeKTX2(volume), "KTX2 3D", Type::_3d, 4, 3, 4 + 2 + 1);
+
+    Description bc1;
+    bc1.format = 131; // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    bc1.width = 20;
+    bc1.height = 12;
+    bc1.levels = 5;
+    bc1.texel_size = 8;
+    bc1.compressed = true;
+    expectValid(makeKTX2(bc1), "KTX2 BC1", Type::_2d, 1, 5, 5, [](const GL::TextureContainer &container) {
+        expect(container.isCompressed() && container.getFormat() == Format::compressed_rgb_s3tc_dxt1,
+               "KTX2 BC1: wrong format");
+        expect(container.getImages().back().size == 5 * 3 * 8, "KTX2 BC1: wrong size of level 0");
+        expect(container.getRowSize(20) == 5 * 8, "KTX2 BC1: wrong row size");
+    });
+
+    // malformed headers
+    const auto valid = makeKTX2(rgba);
+    for (std::size_t size = 0; size < valid.size(); size++)
+    {
+        expectInvalid(File(valid.begin(), valid.begin() + std::ptrdiff_t(size)),
+                      "KTX2 truncated to " + std::to_string(size));
+    }
+
+    auto bad = valid;
+    bad[5] = '1';
+    expectInvalid(bad, "KTX1 identifier");
+
+    auto description = rgba;
+    description.width = 0;
+    expectInvalid(makeKTX2(description), "KTX2 of width 0");
+
+    description = rgba;
+    description.height = 0;
+    expectInvalid(makeKTX2(description), "KTX2 1D");
+
+    description = rgba;
+    description.levels = 6;
+    expectInvalid(makeKTX2(description), "KTX2 with more levels than a 16x8 texture has");
+
+    description = rgba;
+    description.width = 1u << 20;
+    expectInvalid(makeKTX2(description), "KTX2 wider than any texture");
+
+    description = volume;
+    description.layers = 2;
+    expectInvalid(makeKTX2(description), "KTX2 3D array");
+
+    description = bc1;
+    description.depth = 4;
+    description.levels = 1;
+    expectInvalid(makeKTX2(description), "KTX2 3D BC1");
+
+    description = rgba;
+    description.faces = 3;
+    expectInvalid(makeKTX2(description), "KTX2 with 3 faces");
+
+    description = rgba;
+    description.format = 1000;
+    expectInvalid(makeKTX2(description), "KTX2 with an unsupported VkFormat");
+
+    bad = valid;
+    write32(bad, 44, 1);
+    expectInvalid(bad, "supercompressed KTX2");
+
+    bad = valid;
+    write64(bad, 80, valid.size() - 8);
+    expectInvalid(bad, "KTX2 level past the end of the file");
+
+    bad = valid;
+    write64(bad, 88, 16);
+    expectInvalid(bad, "KTX2 level smaller than its image");
+
+    bad = valid;
+    write64(bad, 80, ~std::uint64_t(0) - 4);
+    expectInvalid(bad, "KTX2 level offset that overflows");
+}
+
+void testDDS()
+{
+    Description rgba;
+    rgba.format = 0;
+    rgba.levels = 4;
+    expectValid(makeDDS(rgba, false), "DDS RGBA", Type::_2d, 1, 4, 4, [](const GL::TextureContainer &container) {
+        expect(container.getFormat() == Format::rgba8
+               && container.getDataFormat() == GL::TextureHandle::DataFormat::rgba, "DDS RGBA: wrong format");
+    });
+
+    Description dxt1;
+    dxt1.format = fourCC("DXT1");
+    dxt1.width = 13;
+    dxt1.height = 7;
+    dxt1.levels = 4;
+    dxt1.texel_size = 8;
+    dxt1.compressed = true;
+    expectValid(makeDDS(dxt1, false), "DDS DXT1", Type::_2d, 1, 4, 4, [](const GL::TextureContainer &container) {
+        expect(container.getFormat() == Format::compressed_rgba_s3tc_dxt1, "DDS DXT1: wrong format");
+        expect(container.getImages().back().size == 4 * 2 * 8, "DDS DXT1: wrong size of level 0");
+    });
+
+    Description array = rgba;
+    array.format = 28; // DXGI_FORMAT_R8G8B8A8_UNORM
+    array.layers = 4;
+    expectValid(makeDDS(array, true), "DDS DX10 array", Type::_2d_array, 4, 4, 16);
+
+    Description cube = array;
+    cube.height = 16;
+    cube.layers = 1;
+    cube.faces = 6;
+    expectValid(makeDDS(cube, true), "DDS DX10 cube map", Type::cube_map, 6, 4, 24);
+
+    Description volume = array;
+    volume.layers = 0;
+    volume.depth = 8;
+    volume.levels = 3;
+    expectValid(makeDDS(volume, true), "DDS DX10 3D", Type::_3d, 8, 3, 8 + 4 + 2);
+
+    Description bc7 = dxt1;
+    bc7.format = 98; // DXGI_FORMAT_BC7_UNORM
+    bc7.texel_size = 16;
+    expectValid(makeDDS(bc7, true), "DDS DX10 BC7", Type::_2d, 1, 4, 4);
+
+    // malformed headers
+    const auto valid = makeDDS(array, true);
+    for (std::size_t size = 0; size < valid.size(); size += 7)
+    {
+        expectInvalid(File(valid.begin(), valid.begin() + std::ptrdiff_t(size)),
+                      "DDS truncated to " + std::to_string(size));
+    }
+
+    auto description = rgba;
+    description.width = 0;
+    expectInvalid(makeDDS(description, false), "DDS of width 0");
+
+    description = rgba;
+    description.levels = 20;
+    expectInvalid(makeDDS(description, false), "DDS with more levels than a 16x8 texture has");
+
+    description = volume;
+    description.layers = 2;
+    expectInvalid(makeDDS(description, true), "DDS 3D array");
+
+    description = dxt1;
+    description.depth = 4;
+    description.levels = 1;
+    expectInvalid(makeDDS(description, false), "DDS 3D DXT1");
+
+    description = cube;
+    description.layers = 2;
+    expectInvalid(makeDDS(description, true), "DDS cube map array");
+
+    description = rgba;
+    description.format = fourCC("ETC1");
+    expectInvalid(makeDDS(description, false), "DDS with an unsupported FourCC");
+}
+
+// flipping random bytes of valid files must never make the parser read outside of them
+void testCorruption()
+{
+    Description ktx2;
+    ktx2.layers = 2;
+    ktx2.levels = 4;
+    Description dds;
+    dds.format = 28;
+    dds.layers = 2;
+    dds.levels = 4;
+
+    const File files[] = {makeKTX2(ktx2), makeDDS(dds, true)};
+
+    std::mt19937 random(1);
+    for (const auto &valid: files)
+    {
+        for (int iteration = 0; iteration < 2000; iteration++)
+        {
+            auto file = valid;
+            for (int flip = 0; flip < 4; flip++)
+                file[random() % 160] = static_cast<unsigned char>(random());
+
+            try
+            {
+                checkImages(parse(file), file, "corrupted file " + std::to_string(iteration));
+            }
+            catch (const GL::Error &)
+            {
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testKTX2();
+    testDDS();
+    testCorruption();
+
+    if (g_failures > 0)
+    {
+        std::cerr << g_failures << " failures\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}